@@ -0,0 +1,84 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "common_helpers_p.h"
+
+#include <QTest>
+
+class CommonHelpersTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRemoveAcceleratorMarker_data()
+    {
+        QTest::addColumn<QString>("label");
+        QTest::addColumn<QString>("expected");
+
+        QTest::newRow("empty") << QString() << QString();
+        QTest::newRow("no-marker") << QStringLiteral("Open") << QStringLiteral("Open");
+        QTest::newRow("marker") << QStringLiteral("&Open") << QStringLiteral("Open");
+        QTest::newRow("marker-middle") << QStringLiteral("Op&en File") << QStringLiteral("Open File");
+        QTest::newRow("escaped") << QStringLiteral("Save && &Quit") << QStringLiteral("Save & Quit");
+        QTest::newRow("not-alphanumeric") << QStringLiteral("Drag & Drop") << QStringLiteral("Drag & Drop");
+        QTest::newRow("trailing") << QStringLiteral("Foo&") << QStringLiteral("Foo&");
+        QTest::newRow("cjk-end") << QStringLiteral("打开(&O)...") << QStringLiteral("打开...");
+        QTest::newRow("cjk-start") << QStringLiteral("(&O) 打开") << QStringLiteral("打开");
+        QTest::newRow("cjk-no-ampersand") << QStringLiteral("打开(O)") << QStringLiteral("打开");
+        QTest::newRow("parenthesis-latin") << QStringLiteral("Open (O)") << QStringLiteral("Open (O)");
+    }
+
+    void testRemoveAcceleratorMarker()
+    {
+        QFETCH(QString, label);
+        QFETCH(QString, expected);
+
+        QCOMPARE(removeAcceleratorMarker(label), expected);
+    }
+
+    void testStripAcceleratorMarkers_data()
+    {
+        QTest::addColumn<QString>("label");
+        QTest::addColumn<int>("kind");
+        QTest::addColumn<QString>("expected");
+
+        const int letterOrNumber = int(AcceleratorKind::LetterOrNumber);
+        const int anyCharacter = int(AcceleratorKind::AnyCharacter);
+        QTest::newRow("letter") << QStringLiteral("&Hi") << letterOrNumber << QStringLiteral("Hi");
+        QTest::newRow("letter-escaped") << QStringLiteral("A&&B") << letterOrNumber << QStringLiteral("A&B");
+        QTest::newRow("letter-triple") << QStringLiteral("&&&a") << letterOrNumber << QStringLiteral("&a");
+        QTest::newRow("letter-space") << QStringLiteral("A & B") << letterOrNumber << QStringLiteral("A & B");
+        QTest::newRow("letter-trailing") << QStringLiteral("AB&") << letterOrNumber << QStringLiteral("AB&");
+        QTest::newRow("any-space") << QStringLiteral("A & B") << anyCharacter << QStringLiteral("A  B");
+        QTest::newRow("any-trailing") << QStringLiteral("AB&") << anyCharacter << QStringLiteral("AB");
+        QTest::newRow("any-escaped") << QStringLiteral("&&&Hi&&") << anyCharacter << QStringLiteral("&Hi&");
+    }
+
+    void testStripAcceleratorMarkers()
+    {
+        QFETCH(QString, label);
+        QFETCH(int, kind);
+        QFETCH(QString, expected);
+
+        QCOMPARE(stripAcceleratorMarkers(label, AcceleratorKind(kind)), expected);
+        QCOMPARE(stripAcceleratorMarkers(QStringView(label), AcceleratorKind(kind)), expected);
+    }
+
+    void testFindAcceleratorMarker()
+    {
+        QCOMPARE(findAcceleratorMarker(u"Open", AcceleratorKind::Printable), qsizetype(-1));
+        QCOMPARE(findAcceleratorMarker(u"Op&en", AcceleratorKind::Printable), qsizetype(2));
+        QCOMPARE(findAcceleratorMarker(u"A&&B &C", AcceleratorKind::Printable), qsizetype(5));
+        QCOMPARE(findAcceleratorMarker(u"A & B", AcceleratorKind::Printable), qsizetype(2));
+        QCOMPARE(findAcceleratorMarker(u"A & B", AcceleratorKind::LetterOrNumber), qsizetype(-1));
+        QCOMPARE(findAcceleratorMarker(u"AB&", AcceleratorKind::AnyCharacter), qsizetype(-1));
+    }
+};
+
+QTEST_MAIN(CommonHelpersTest)
+
+#include "commonhelperstest.moc"
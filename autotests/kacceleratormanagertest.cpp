@@ -6,7 +6,11 @@
 */
 #include <functional>
 #include <kacceleratormanager.h>
+#include <limits>
 
+#include "kacceleratormanager_p.h"
+
+#include <QGroupBox>
 #include <QMenu>
 #include <QPushButton>
 #include <QTest>
@@ -76,6 +80,101 @@ private Q_SLOTS:
         QCOMPARE(texts, expectedTexts);
     }
 
+    void testChangedMenuTexts()
+    {
+        // GIVEN
+        KAccelManagerAlgorithm::clearCache();
+        const int hits = KAccelManagerAlgorithm::cacheHits();
+        const int misses = KAccelManagerAlgorithm::cacheMisses();
+        QMenu menu;
+        menu.addAction(QSL("Open"));
+        menu.addAction(QSL("Close"));
+        menu.addAction(QSL("Quit"));
+        KAcceleratorManager::manage(&menu);
+        const QStringList expectedTexts{QSL("&Open"), QSL("&Close"), QSL("&Quit")};
+        QCOMPARE(extractActionTexts(menu, &QAction::text), expectedTexts);
+        QCOMPARE(KAccelManagerAlgorithm::cacheMisses(), misses + 1);
+        // WHEN showing the unchanged menu again
+        // THEN nothing is calculated
+        QCOMPARE(extractActionTexts(menu, &QAction::text), expectedTexts);
+        QCOMPARE(KAccelManagerAlgorithm::cacheMisses(), misses + 1);
+        QCOMPARE(KAccelManagerAlgorithm::cacheHits(), hits);
+        // WHEN an action is added
+        QAction *copy = menu.addAction(QSL("Copy"));
+        // THEN it gets a free accelerator, the others are kept
+        QCOMPARE(extractActionTexts(menu, &QAction::text), expectedTexts + QStringList{QSL("Co&py")});
+        QCOMPARE(KAccelManagerAlgorithm::cacheMisses(), misses + 2);
+        // WHEN it is removed again
+        menu.removeAction(copy);
+        // THEN
+        QCOMPARE(extractActionTexts(menu, &QAction::text), expectedTexts);
+        QCOMPARE(KAccelManagerAlgorithm::cacheMisses(), misses + 3);
+        delete copy;
+        // WHEN it is added once more
+        menu.addAction(QSL("Copy"));
+        // THEN the previous distribution is reused
+        QCOMPARE(extractActionTexts(menu, &QAction::text), expectedTexts + QStringList{QSL("Co&py")});
+        QCOMPARE(KAccelManagerAlgorithm::cacheMisses(), misses + 3);
+        QCOMPARE(KAccelManagerAlgorithm::cacheHits(), hits + 1);
+    }
+
+    void testManyTexts()
+    {
+        // GIVEN enough texts to calculate the weights on several threads
+        const auto manageButtons = []() {
+            QWidget widget;
+            QList<QPushButton *> buttons;
+            for (int i = 0; i < 1000; ++i) {
+                buttons.append(new QPushButton(QSL("Item %1").arg(i), &widget));
+            }
+            KAccelManagerAlgorithm::clearCache();
+            KAcceleratorManager::manage(&widget);
+            QStringList texts;
+            for (const QPushButton *button : std::as_const(buttons)) {
+                texts.append(button->text());
+            }
+            return texts;
+        };
+        // WHEN
+        const QStringList texts = manageButtons();
+        KAccelManagerAlgorithm::setMinParallelWeights(std::numeric_limits<int>::max());
+        const QStringList sequentialTexts = manageButtons();
+        KAccelManagerAlgorithm::setMinParallelWeights(-1);
+        // THEN the result is the same as without threads
+        QCOMPARE(texts, sequentialTexts);
+        // AND every accelerator is used only once
+        QCOMPARE(texts.first(), QSL("&Item 0"));
+        QString used;
+        for (const QString &text : texts) {
+            const int pos = text.indexOf(QLatin1Char('&'));
+            if (pos >= 0) {
+                const QChar accel = text.at(pos + 1).toLower();
+                QVERIFY2(!used.contains(accel), qPrintable(text));
+                used.append(accel);
+            }
+        }
+    }
+
+    void testWidgetTexts()
+    {
+        // GIVEN
+        QWidget widget;
+        auto *open = new QPushButton(QSL("Open"), &widget);
+        auto *close = new QPushButton(QSL("Close"), &widget);
+        auto *options = new QGroupBox(QSL("Options"), &widget);
+        auto *advanced = new QGroupBox(QSL("Advanced"), &widget);
+        advanced->setCheckable(true);
+        // WHEN
+        KAcceleratorManager::manage(&widget);
+        // THEN
+        QCOMPARE(open->text(), QSL("&Open"));
+        QCOMPARE(close->text(), QSL("&Close"));
+        // non-checkable group boxes only reserve an accelerator
+        QCOMPARE(options->title(), QSL("Options"));
+        QCOMPARE(advanced->title(), QSL("&Advanced"));
+        QVERIFY(widget.updatesEnabled());
+    }
+
     void testExistingActionsShortcutsAreTakenIntoAccount()
     {
         std::unique_ptr<QWidget> w(new QWidget());
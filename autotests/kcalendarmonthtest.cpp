@@ -0,0 +1,70 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "kcalendarmonth_p.h"
+
+#include <QTest>
+
+class KCalendarMonthTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testShared()
+    {
+        const QLocale us(QLocale::English, QLocale::UnitedStates);
+        const QLocale german(QLocale::German, QLocale::Germany);
+
+        const auto month = KCalendarMonth::get(2023, 5, us);
+        QCOMPARE(KCalendarMonth::get(2023, 5, us), month);
+        QVERIFY(KCalendarMonth::get(2023, 6, us) != month);
+        QVERIFY(KCalendarMonth::get(2023, 5, german) != month);
+    }
+
+    void testLayout()
+    {
+        // May 1st 2023 is a Monday
+        const auto us = KCalendarMonth::get(2023, 5, QLocale(QLocale::English, QLocale::UnitedStates));
+        QCOMPARE(us->year(), 2023);
+        QCOMPARE(us->month(), 5);
+        QCOMPARE(us->weekDay(0), int(Qt::Sunday));
+        QCOMPARE(us->weekDay(1), int(Qt::Monday));
+        QVERIFY(!us->isWorkingDay(0));
+        QVERIFY(us->isWorkingDay(1));
+        QCOMPARE(us->date(0), QDate(2023, 4, 30));
+        QCOMPARE(us->date(1), QDate(2023, 5, 1));
+        QCOMPARE(us->date(KCalendarMonth::Cells - 1), QDate(2023, 6, 10));
+        QCOMPARE(us->date(KCalendarMonth::Cells), QDate(2023, 6, 11));
+        QCOMPARE(us->dayLabel(1), QStringLiteral("1"));
+        QCOMPARE(us->position(QDate(2023, 5, 1)), 2);
+        QCOMPARE(us->weekNumber(1), 18);
+
+        // at least one day of the previous month is always shown
+        const auto german = KCalendarMonth::get(2023, 5, QLocale(QLocale::German, QLocale::Germany));
+        QCOMPARE(german->weekDay(0), int(Qt::Monday));
+        QCOMPARE(german->weekDay(6), int(Qt::Sunday));
+        QCOMPARE(german->date(0), QDate(2023, 4, 24));
+        QCOMPARE(german->date(7), QDate(2023, 5, 1));
+        QCOMPARE(german->shortDayName(0), QLocale(QLocale::German, QLocale::Germany).dayName(Qt::Monday, QLocale::ShortFormat));
+    }
+
+    void testWeeksOfYear()
+    {
+        // January 1st 2023 is a Sunday in the last week of 2022
+        const QList<KCalendarMonth::Week> weeks = KCalendarMonth::weeksOfYear(2023);
+        QCOMPARE(weeks.size(), qsizetype(53));
+        QCOMPARE(weeks.first().firstDay, QDate(2023, 1, 1));
+        QCOMPARE(weeks.first().number, 52);
+        QCOMPARE(weeks.first().year, 2022);
+        QCOMPARE(weeks.at(1).number, 1);
+        QCOMPARE(weeks.at(1).year, 2023);
+    }
+};
+
+QTEST_GUILESS_MAIN(KCalendarMonthTest)
+
+#include "kcalendarmonthtest.moc"
@@ -9,6 +9,28 @@
 #include <QComboBox>
 #include <QLineEdit>
 #include <QTest>
+#include <QTextBrowser>
+#include <QTranslator>
+
+#include <algorithm>
+
+// translates a single string, to check that the details follow language changes
+class TestTranslator : public QTranslator
+{
+public:
+    QString translate(const char *context, const char *sourceText, const char *disambiguation, int n) const override
+    {
+        Q_UNUSED(context);
+        Q_UNUSED(disambiguation);
+        Q_UNUSED(n);
+        return qstrcmp(sourceText, "Character:") == 0 ? QStringLiteral("Zeichen:") : QString();
+    }
+
+    bool isEmpty() const override
+    {
+        return false;
+    }
+};
 
 class KCharSelectTest : public QObject
 {
@@ -35,6 +57,50 @@ private Q_SLOTS:
         QCOMPARE(selector.currentCodePoint(), 128);
     }
 
+    void allSection()
+    {
+        KCharSelect selector(nullptr, nullptr);
+        QComboBox *sectionCombo = selector.findChild<QComboBox *>(QStringLiteral("sectionCombo"));
+        QVERIFY(sectionCombo);
+        sectionCombo->setCurrentIndex(1);
+        sectionCombo->setCurrentIndex(0); // "All"
+        const QList<uint> codePoints = selector.displayedCodePoints();
+        QVERIFY(codePoints.count() > 50000);
+        QVERIFY(std::is_sorted(codePoints.cbegin(), codePoints.cend()));
+        QVERIFY(codePoints.contains(0x4E00));
+        selector.setCurrentCodePoint(0x4E00);
+        QCOMPARE(selector.currentCodePoint(), 0x4E00);
+    }
+
+    void detailsOfQuickChanges()
+    {
+        KCharSelect selector(nullptr, nullptr);
+        QTextBrowser *detailBrowser = selector.findChild<QTextBrowser *>();
+        QVERIFY(detailBrowser);
+        // the details of the last character are shown once the changes stop
+        selector.setCurrentCodePoint(0x41);
+        selector.setCurrentCodePoint(0x42);
+        selector.setCurrentCodePoint(0x43);
+        QTRY_VERIFY(detailBrowser->toPlainText().contains(QLatin1String("LATIN CAPITAL LETTER C")));
+        selector.setCurrentCodePoint(0x41);
+        QTRY_VERIFY(detailBrowser->toPlainText().contains(QLatin1String("LATIN CAPITAL LETTER A")));
+    }
+
+    void detailsAfterLanguageChange()
+    {
+        KCharSelect selector(nullptr, nullptr);
+        QTextBrowser *detailBrowser = selector.findChild<QTextBrowser *>();
+        QVERIFY(detailBrowser);
+        selector.setCurrentCodePoint(0x41);
+        QTRY_VERIFY(detailBrowser->toPlainText().contains(QLatin1String("Character:")));
+        // WHEN the language changes
+        TestTranslator translator;
+        QCoreApplication::installTranslator(&translator);
+        // THEN the details are not taken from the cache
+        QTRY_VERIFY(detailBrowser->toPlainText().contains(QLatin1String("Zeichen:")));
+        QCoreApplication::removeTranslator(&translator);
+    }
+
     void search2Chars()
     {
         KCharSelect selector(nullptr, nullptr);
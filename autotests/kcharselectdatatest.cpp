@@ -0,0 +1,115 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "kcharselectdata_p.h"
+
+#include <QFile>
+#include <QTest>
+#include <QtEndian>
+
+static QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+class KCharSelectDataTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testVersion1()
+    {
+        KCharSelectData data;
+        QVERIFY(data.loadDataFile(readFile(QFINDTESTDATA("../src/kcharselect-data"))));
+        QCOMPARE(data.name(0x41), QStringLiteral("LATIN CAPITAL LETTER A"));
+        QCOMPARE(data.category(0x41), QChar::Letter_Uppercase);
+        QVERIFY(data.find(QStringLiteral("capital letter a")).contains(0x41));
+    }
+
+    void testVersion2()
+    {
+        // generated by kcharselect-generate-datafile.py from a handful of characters
+        KCharSelectData data;
+        QVERIFY(data.loadDataFile(readFile(QFINDTESTDATA("kcharselect-data-v2-sample"))));
+
+        QCOMPARE(data.name(0x1F600), QStringLiteral("GRINNING FACE"));
+        QCOMPARE(data.category(0x1F600), QChar::Symbol_Other);
+        QCOMPARE(data.aliases(0x1F600), QStringList{QStringLiteral("smiley")});
+        QCOMPARE(data.seeAlso(0x1F600), QList<uint>{0x1F603});
+        QCOMPARE(data.notes(0x61), QStringList{QStringLiteral("lowercase of A")});
+        QVERIFY(data.aliases(0x41).isEmpty());
+
+        QCOMPARE(data.block(0x1F600), QStringLiteral("Emoticons"));
+        QCOMPARE(data.section(0x1F600), QStringLiteral("Symbols"));
+        // blocks without a section end up in "Other"
+        QCOMPARE(data.block(0x10000), QStringLiteral("Linear B Syllabary"));
+        QCOMPARE(data.section(0x10000), QStringLiteral("Other"));
+
+        const QStringList unihan = data.unihanInfo(0x4E00);
+        QCOMPARE(unihan.size(), 7);
+        QCOMPARE(unihan.at(0), QStringLiteral("one; a, an; alone"));
+        QVERIFY(data.unihanInfo(0x41).isEmpty());
+
+        QVERIFY(data.find(QStringLiteral("grinning")).contains(0x1F600));
+        QVERIFY(data.find(QStringLiteral("happy face")).contains(0x1F603));
+        QVERIFY(data.find(QStringLiteral("1F603")).contains(0x1F600));
+    }
+
+    void testUnihanSearch_data()
+    {
+        QTest::addColumn<QString>("needle");
+        QTest::addColumn<bool>("found");
+
+        QTest::newRow("definition") << QStringLiteral("alone") << true;
+        QTest::newRow("prefix") << QStringLiteral("alo") << true;
+        QTest::newRow("two words") << QStringLiteral("one alone") << true;
+        QTest::newRow("cantonese") << QStringLiteral("jat1") << true;
+        QTest::newRow("mandarin") << QStringLiteral("Yī") << true;
+        QTest::newRow("missing") << QStringLiteral("zebra") << false;
+        QTest::newRow("after the last token") << QStringLiteral("zzz") << false;
+    }
+
+    void testUnihanSearch()
+    {
+        QFETCH(QString, needle);
+        QFETCH(bool, found);
+
+        KCharSelectData data;
+        QVERIFY(data.loadDataFile(readFile(QFINDTESTDATA("kcharselect-data-v2-sample"))));
+        QVERIFY(data.unihanIndexSize() > 0);
+        QCOMPARE(data.find(needle).contains(0x4E00), found);
+    }
+
+    void testInvalidData()
+    {
+        KCharSelectData data;
+        QVERIFY(!data.loadDataFile(QByteArray("KCSD")));
+
+        const QByteArray sample = readFile(QFINDTESTDATA("kcharselect-data-v2-sample"));
+        QVERIFY(!data.loadDataFile(sample.left(sample.size() - 1)));
+
+        // the names begin after the end of the file
+        QByteArray corrupted = sample;
+        qToLittleEndian<quint32>(sample.size() + 1, corrupted.data() + 16);
+        QVERIFY(!data.loadDataFile(corrupted));
+
+        // the names do not consist of whole entries
+        corrupted = sample;
+        qToLittleEndian<quint32>(qFromLittleEndian<quint32>(sample.constData() + 16) + 1, corrupted.data() + 16);
+        QVERIFY(!data.loadDataFile(corrupted));
+
+        QVERIFY(data.loadDataFile(sample));
+    }
+};
+
+QTEST_GUILESS_MAIN(KCharSelectDataTest)
+
+#include "kcharselectdatatest.moc"
@@ -0,0 +1,75 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KColorCombo>
+
+#include <QTest>
+
+class KColorComboTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testStandardColors()
+    {
+        KColorCombo combo;
+        const QList<QColor> colors = combo.colors();
+        QVERIFY(!colors.isEmpty());
+        QCOMPARE(combo.count(), int(colors.size()) + 1);
+        QCOMPARE(combo.currentIndex(), 1);
+        QCOMPARE(combo.color(), colors.first());
+    }
+
+    void testSetColor()
+    {
+        KColorCombo combo;
+        combo.setColor(Qt::red);
+        QCOMPARE(combo.color(), QColor(Qt::red));
+        QVERIFY(!combo.isCustomColor());
+
+        const QColor custom(1, 2, 3);
+        combo.setColor(custom);
+        QCOMPARE(combo.color(), custom);
+        QVERIFY(combo.isCustomColor());
+        QCOMPARE(combo.itemData(0, Qt::UserRole + 1).value<QColor>(), custom);
+    }
+
+    void testNamedColors()
+    {
+        const QList<QColor> colors{Qt::red, Qt::green, Qt::blue};
+        const QStringList names{QStringLiteral("Red"), QStringLiteral("Green"), QStringLiteral("Blue")};
+
+        KColorCombo combo;
+        combo.setColors(colors, names);
+        QCOMPARE(combo.colors(), colors);
+        QCOMPARE(combo.count(), 4);
+        QCOMPARE(combo.findText(QStringLiteral("Green")), 2);
+        QCOMPARE(combo.itemData(3, Qt::ToolTipRole).toString(), QStringLiteral("Blue"));
+
+        combo.setColor(Qt::blue);
+        QCOMPARE(combo.currentIndex(), 3);
+        QCOMPARE(combo.color(), QColor(Qt::blue));
+
+        combo.setColors(colors);
+        QCOMPARE(combo.findText(QStringLiteral("Green")), -1);
+    }
+
+    void testShowEmptyList()
+    {
+        KColorCombo combo;
+        combo.showEmptyList();
+        QCOMPARE(combo.count(), 0);
+
+        combo.setColor(Qt::black);
+        QCOMPARE(combo.count(), int(combo.colors().size()) + 1);
+        QCOMPARE(combo.color(), QColor(Qt::black));
+    }
+};
+
+QTEST_MAIN(KColorComboTest)
+
+#include "kcolorcombotest.moc"
@@ -3,6 +3,7 @@
     SPDX-License-Identifier: LGPL-2.0-or-later
 */
 
+#include <KDatePicker>
 #include <KDatePickerPopup>
 
 #include <QSignalSpy>
@@ -111,6 +112,29 @@ private Q_SLOTS:
         QCOMPARE(p.actions().count(), 9);
         p.hide();
     }
+
+    void testLazyDatePicker()
+    {
+        KDatePickerPopup p(KDatePickerPopup::DatePicker | KDatePickerPopup::Words, QDate(2023, 5, 17));
+        QVERIFY(!p.findChild<KDatePicker *>());
+
+        p.setDate(QDate(2023, 6, 1));
+        QVERIFY(!p.findChild<KDatePicker *>());
+
+        p.popup(QPoint());
+        KDatePicker *picker = p.findChild<KDatePicker *>();
+        QVERIFY(picker);
+        QCOMPARE(picker, p.datePicker());
+        QCOMPARE(picker->date(), QDate(2023, 6, 1));
+        p.hide();
+
+        QSignalSpy spy(&p, &KDatePickerPopup::dateChanged);
+        p.setDate(QDate(2023, 7, 4));
+        QCOMPARE(picker->date(), QDate(2023, 7, 4));
+        Q_EMIT picker->dateSelected(QDate(2023, 7, 5));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toDate(), QDate(2023, 7, 5));
+    }
 };
 
 QTEST_MAIN(KDatePickerPopupTest)
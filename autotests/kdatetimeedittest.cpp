@@ -215,6 +215,33 @@ void KDateTimeEditTest::testTimeSpec()
     delete m_edit;
 }
 
+void KDateTimeEditTest::testTimeZoneCombo()
+{
+    m_edit = new KDateTimeEdit();
+    m_edit->setOptions(m_edit->options() | KDateTimeEdit::ShowTimeZone | KDateTimeEdit::SelectTimeZone);
+
+    QComboBox *combo = m_edit->findChild<QComboBox *>(QStringLiteral("m_timeZoneCombo"));
+    QVERIFY(combo);
+    // Only UTC and Floating until the combo box is used
+    QCOMPARE(combo->count(), 2);
+    QCOMPARE(combo->itemData(0).toByteArray(), QByteArray("UTC"));
+
+    QTest::keyClick(combo, Qt::Key_Down);
+    const auto zoneIds = QTimeZone::availableTimeZoneIds();
+    QCOMPARE(combo->count(), int(zoneIds.size()) + 2);
+    if (!zoneIds.isEmpty()) {
+        QCOMPARE(combo->itemData(2).toByteArray(), zoneIds.first());
+        QCOMPARE(combo->itemText(2), QString::fromUtf8(zoneIds.first()));
+    }
+
+    const QList<QTimeZone> zones{QTimeZone(3600), QTimeZone(QByteArrayLiteral("UTC"))};
+    m_edit->setTimeZones(zones);
+    QCOMPARE(combo->count(), 4);
+    QCOMPARE(combo->itemData(2).toByteArray(), zones.at(0).id());
+
+    delete m_edit;
+}
+
 template<typename T>
 static T findVisibleChild(QWidget *parent)
 {
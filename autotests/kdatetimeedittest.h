@@ -27,6 +27,7 @@ private Q_SLOTS:
     void testTimeDisplayFormat();
     void testCalendarSystem();
     void testTimeSpec();
+    void testTimeZoneCombo();
     void testDateMenu();
 
 private:
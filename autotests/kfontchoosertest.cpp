@@ -0,0 +1,44 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+#include <kfontchooser.h>
+
+#include <QListWidget>
+#include <QTest>
+
+class KFontChooserTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testFamilyPreview()
+    {
+        // GIVEN
+        KFontChooser chooser;
+        QListWidget *familyList = chooser.findChild<QListWidget *>(QStringLiteral("familyListWidget"));
+        QVERIFY(familyList);
+        QVERIFY(familyList->count() > 0);
+        QAbstractItemDelegate *defaultDelegate = familyList->itemDelegate();
+        QVERIFY(!chooser.isFamilyPreviewEnabled());
+        // WHEN
+        chooser.setFamilyPreviewEnabled(true);
+        // THEN the list can be painted while the previews are rendered, and once they are there
+        QVERIFY(chooser.isFamilyPreviewEnabled());
+        QVERIFY(familyList->itemDelegate() != defaultDelegate);
+        QVERIFY(!familyList->grab().isNull());
+        QTest::qWait(100);
+        QVERIFY(!familyList->grab().isNull());
+        // WHEN
+        chooser.setFamilyPreviewEnabled(false);
+        // THEN
+        QVERIFY(!chooser.isFamilyPreviewEnabled());
+        QCOMPARE(familyList->itemDelegate(), defaultDelegate);
+    }
+};
+
+QTEST_MAIN(KFontChooserTest)
+
+#include "kfontchoosertest.moc"
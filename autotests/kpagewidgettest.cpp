@@ -0,0 +1,60 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KPageWidget>
+
+#include <QPointer>
+#include <QTabWidget>
+#include <QTest>
+
+class KPageWidgetTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testTabbedPages()
+    {
+        KPageWidget pageWidget;
+        pageWidget.setFaceType(KPageView::Tabbed);
+
+        QWidget *first = new QWidget;
+        QWidget *second = new QWidget;
+        KPageWidgetItem *firstItem = pageWidget.addPage(first, QStringLiteral("First"));
+        KPageWidgetItem *secondItem = pageWidget.addPage(second, QStringLiteral("Second"));
+
+        QTabWidget *tabWidget = pageWidget.findChild<QTabWidget *>();
+        QVERIFY(tabWidget);
+        QCOMPARE(tabWidget->count(), 2);
+        QCOMPARE(tabWidget->tabText(1), QStringLiteral("Second"));
+
+        pageWidget.setCurrentPage(secondItem);
+        QCOMPARE(tabWidget->currentIndex(), 1);
+        QWidget *const secondWrapper = second->parentWidget();
+
+        // inserting a page in front keeps the current page and does not touch the others
+        QWidget *inserted = new QWidget;
+        pageWidget.insertPage(firstItem, inserted, QStringLiteral("Inserted"));
+        QCOMPARE(tabWidget->count(), 3);
+        QCOMPARE(tabWidget->tabText(0), QStringLiteral("Inserted"));
+        QCOMPARE(tabWidget->currentIndex(), 2);
+        QCOMPARE(pageWidget.currentPage(), secondItem);
+        QCOMPARE(second->parentWidget(), secondWrapper);
+
+        // removing a page drops its tab and wrapper
+        QPointer<QWidget> firstWrapper = first->parentWidget();
+        pageWidget.removePage(firstItem);
+        QCOMPARE(tabWidget->count(), 2);
+        QCOMPARE(tabWidget->tabText(1), QStringLiteral("Second"));
+        QVERIFY(!firstWrapper);
+        QCOMPARE(pageWidget.currentPage(), secondItem);
+        QCOMPARE(second->parentWidget(), secondWrapper);
+    }
+};
+
+QTEST_MAIN(KPageWidgetTest)
+
+#include "kpagewidgettest.moc"
@@ -0,0 +1,87 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+#include <KPixmapRegionSelectorWidget>
+
+#include <QTest>
+
+static QImage createTestImage()
+{
+    QImage image(40, 20, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            image.setPixel(x, y, qRgb(x * 6, y * 12, (x + y) % 256));
+        }
+    }
+    return image;
+}
+
+class KPixmapRegionSelectorWidgetTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSelectedImage()
+    {
+        const QImage image = createTestImage();
+        KPixmapRegionSelectorWidget w;
+        w.setPixmap(QPixmap::fromImage(image));
+        QCOMPARE(w.selectedRegion(), image.rect());
+
+        const QRect region(2, 3, 5, 7);
+        w.setSelectedRegion(region);
+        QCOMPARE(w.selectedImage().convertToFormat(QImage::Format_RGB32), image.copy(region));
+    }
+
+    void testSelectedImageAfterRotation_data()
+    {
+        QTest::addColumn<int>("direction");
+        QTest::addColumn<qreal>("angle");
+
+        QTest::newRow("90") << int(KPixmapRegionSelectorWidget::Rotate90) << 90.0;
+        QTest::newRow("180") << int(KPixmapRegionSelectorWidget::Rotate180) << 180.0;
+        QTest::newRow("270") << int(KPixmapRegionSelectorWidget::Rotate270) << 270.0;
+    }
+
+    void testSelectedImageAfterRotation()
+    {
+        QFETCH(int, direction);
+        QFETCH(qreal, angle);
+
+        const QImage image = createTestImage();
+        const QImage rotated = image.transformed(QTransform().rotate(angle));
+        KPixmapRegionSelectorWidget w;
+        w.setPixmap(QPixmap::fromImage(image));
+        w.rotate(KPixmapRegionSelectorWidget::RotateDirection(direction));
+        QCOMPARE(w.pixmap().size(), rotated.size());
+
+        const QRect region(1, 4, 6, 3);
+        w.setSelectedRegion(region);
+        QCOMPARE(w.selectedImage().convertToFormat(QImage::Format_RGB32), rotated.copy(region));
+        QCOMPARE(w.pixmap().toImage().convertToFormat(QImage::Format_RGB32), rotated);
+    }
+
+    void testMaximumWidgetSize()
+    {
+        const QImage image = createTestImage();
+        KPixmapRegionSelectorWidget w;
+        w.setPixmap(QPixmap::fromImage(image));
+        w.setMaximumWidgetSize(20, 20);
+
+        QCOMPARE(w.selectedRegion(), QRect(0, 0, 20, 10));
+        QCOMPARE(w.unzoomedSelectedRegion(), image.rect());
+        QCOMPARE(w.selectedImage().convertToFormat(QImage::Format_RGB32), image);
+
+        w.rotateClockwise();
+        w.setMaximumWidgetSize(20, 20);
+        QCOMPARE(w.selectedRegion(), QRect(0, 0, 10, 20));
+        QCOMPARE(w.unzoomedSelectedRegion(), QRect(0, 0, 20, 40));
+    }
+};
+
+QTEST_MAIN(KPixmapRegionSelectorWidgetTest)
+
+#include "kpixmapregionselectorwidgettest.moc"
@@ -0,0 +1,75 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KStyleExtensions>
+
+#include <QLabel>
+#include <QProxyStyle>
+#include <QPushButton>
+#include <QTest>
+
+// answers custom element queries with a different id for push buttons
+class CustomElementsStyle : public QProxyStyle
+{
+    Q_OBJECT
+    Q_CLASSINFO("X-KDE-CustomElements", "true")
+
+public:
+    int styleHint(StyleHint hint, const QStyleOption *option, const QWidget *widget, QStyleHintReturn *returnData) const override
+    {
+        if (hint == StyleHint(0xff000001) && widget && widget->objectName() == QLatin1String("CE_Test")) {
+            ++queries;
+            return qobject_cast<const QPushButton *>(widget) ? 0xff000010 : 0xff000020;
+        }
+        return QProxyStyle::styleHint(hint, option, widget, returnData);
+    }
+
+    mutable int queries = 0;
+};
+
+class KStyleExtensionsTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testCustomElementPerWidgetClass()
+    {
+        // GIVEN
+        CustomElementsStyle style;
+        QPushButton button;
+        button.setStyle(&style);
+        QLabel label;
+        label.setStyle(&style);
+        // WHEN
+        const QStyle::ControlElement buttonElement = KStyleExtensions::customControlElement(QStringLiteral("CE_Test"), &button);
+        const QStyle::ControlElement labelElement = KStyleExtensions::customControlElement(QStringLiteral("CE_Test"), &label);
+        // THEN every widget class gets the answer of the style for it
+        QCOMPARE(int(buttonElement), 0xff000010);
+        QCOMPARE(int(labelElement), 0xff000020);
+        QCOMPARE(style.queries, 2);
+        // WHEN querying again
+        QPushButton otherButton;
+        otherButton.setStyle(&style);
+        // THEN the cached ids are used
+        QCOMPARE(int(KStyleExtensions::customControlElement(QStringLiteral("CE_Test"), &otherButton)), 0xff000010);
+        QCOMPARE(int(KStyleExtensions::customControlElement(QStringLiteral("CE_Test"), &label)), 0xff000020);
+        QCOMPARE(style.queries, 2);
+        QCOMPARE(button.objectName(), QString());
+    }
+
+    void testUnsupportedStyle()
+    {
+        QProxyStyle style;
+        QPushButton button;
+        button.setStyle(&style);
+        QCOMPARE(int(KStyleExtensions::customControlElement(QStringLiteral("CE_Test"), &button)), 0);
+    }
+};
+
+QTEST_MAIN(KStyleExtensionsTest)
+
+#include "kstyleextensionstest.moc"
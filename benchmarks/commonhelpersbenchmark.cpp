@@ -0,0 +1,80 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "common_helpers_p.h"
+
+#include <QTest>
+
+class CommonHelpersBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void removeMarker_data();
+    void removeMarker();
+    void stripMarkers_data();
+    void stripMarkers();
+};
+
+void CommonHelpersBenchmark::removeMarker_data()
+{
+    QTest::addColumn<QStringList>("labels");
+
+    QTest::newRow("menu") << QStringList{QStringLiteral("&New"),
+                                         QStringLiteral("&Open..."),
+                                         QStringLiteral("Open &Recent"),
+                                         QStringLiteral("&Save"),
+                                         QStringLiteral("Save &As..."),
+                                         QStringLiteral("Save A&ll"),
+                                         QStringLiteral("Re&load"),
+                                         QStringLiteral("&Print..."),
+                                         QStringLiteral("Print Previe&w"),
+                                         QStringLiteral("Export as &HTML && PDF..."),
+                                         QStringLiteral("&Close"),
+                                         QStringLiteral("&Quit")};
+    QTest::newRow("cjk") << QStringList{QStringLiteral("新建(&N)"),
+                                        QStringLiteral("打开(&O)..."),
+                                        QStringLiteral("最近打开的文件(&R)"),
+                                        QStringLiteral("保存(&S)"),
+                                        QStringLiteral("另存为(&A)..."),
+                                        QStringLiteral("全部保存(&L)"),
+                                        QStringLiteral("重新加载(&E)"),
+                                        QStringLiteral("打印(&P)..."),
+                                        QStringLiteral("关闭(&C)"),
+                                        QStringLiteral("退出(&Q)")};
+}
+
+void CommonHelpersBenchmark::removeMarker()
+{
+    QFETCH(QStringList, labels);
+
+    QBENCHMARK {
+        for (const QString &label : std::as_const(labels)) {
+            removeAcceleratorMarker(label);
+        }
+    }
+}
+
+void CommonHelpersBenchmark::stripMarkers_data()
+{
+    removeMarker_data();
+}
+
+void CommonHelpersBenchmark::stripMarkers()
+{
+    QFETCH(QStringList, labels);
+
+    QBENCHMARK {
+        for (const QString &label : std::as_const(labels)) {
+            stripAcceleratorMarkers(label, AcceleratorKind::LetterOrNumber);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(CommonHelpersBenchmark)
+
+#include "commonhelpersbenchmark.moc"
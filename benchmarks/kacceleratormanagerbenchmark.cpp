@@ -0,0 +1,91 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KAcceleratorManager>
+
+#include "kacceleratormanager_p.h"
+
+#include <QCheckBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTest>
+#include <QVBoxLayout>
+
+// KAccelManagerAlgorithm::findAccelerators() is exercised by managing a
+// dialog-like widget tree.
+class KAcceleratorManagerBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void manage_data();
+    void manage();
+};
+
+void KAcceleratorManagerBenchmark::manage_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("10 rows") << 10 << false;
+    QTest::newRow("50 rows") << 50 << false;
+    QTest::newRow("200 rows") << 200 << false;
+    // the same window managed again, the distribution comes from the cache
+    QTest::newRow("200 rows, cached") << 200 << true;
+}
+
+void KAcceleratorManagerBenchmark::manage()
+{
+    QFETCH(int, rows);
+    QFETCH(bool, cached);
+
+    QWidget window;
+    auto *layout = new QVBoxLayout(&window);
+    QList<QLabel *> labels;
+    QList<QAbstractButton *> buttons;
+    for (int i = 0; i < rows; ++i) {
+        auto *label = new QLabel(&window);
+        auto *lineEdit = new QLineEdit(&window);
+        label->setBuddy(lineEdit);
+        labels.append(label);
+        buttons.append(new QCheckBox(&window));
+        buttons.append(new QPushButton(&window));
+        layout->addWidget(label);
+        layout->addWidget(lineEdit);
+        layout->addWidget(buttons.at(buttons.size() - 2));
+        layout->addWidget(buttons.last());
+    }
+
+    // managing the window adds accelerators to the texts, every
+    // iteration starts again from the texts without them
+    const auto resetTexts = [&labels, &buttons]() {
+        for (int i = 0; i < labels.size(); ++i) {
+            labels.at(i)->setText(QStringLiteral("&Option number %1:").arg(i));
+            buttons.at(2 * i)->setText(QStringLiteral("Enable feature %1").arg(i));
+            buttons.at(2 * i + 1)->setText(QStringLiteral("Apply setting %1").arg(i));
+        }
+    };
+
+    KAccelManagerAlgorithm::clearCache();
+    if (cached) {
+        resetTexts();
+        KAcceleratorManager::manage(&window);
+    }
+
+    QBENCHMARK {
+        if (!cached) {
+            KAccelManagerAlgorithm::clearCache();
+        }
+        resetTexts();
+        KAcceleratorManager::manage(&window);
+    }
+}
+
+QTEST_MAIN(KAcceleratorManagerBenchmark)
+
+#include "kacceleratormanagerbenchmark.moc"
@@ -0,0 +1,50 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KCharSelect>
+
+#include <QLineEdit>
+#include <QTest>
+
+// KCharSelectData::find() is private, it is exercised through the search line edit.
+class KCharSelectBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void find_data();
+    void find();
+};
+
+void KCharSelectBenchmark::find_data()
+{
+    QTest::addColumn<QString>("searchText");
+
+    QTest::newRow("single letter") << QStringLiteral("a");
+    QTest::newRow("word") << QStringLiteral("latin");
+    QTest::newRow("two words") << QStringLiteral("greek small");
+    QTest::newRow("code point") << QStringLiteral("U+20AC");
+    QTest::newRow("no match") << QStringLiteral("qqqqqq");
+}
+
+void KCharSelectBenchmark::find()
+{
+    QFETCH(QString, searchText);
+
+    KCharSelect selector(nullptr, nullptr);
+    QLineEdit *searchLineEdit = selector.findChild<QLineEdit *>();
+    QVERIFY(searchLineEdit);
+
+    QBENCHMARK {
+        searchLineEdit->setText(searchText);
+        Q_EMIT searchLineEdit->returnPressed();
+    }
+}
+
+QTEST_MAIN(KCharSelectBenchmark)
+
+#include "kcharselectbenchmark.moc"
@@ -0,0 +1,84 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "kcharselectdata_p.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTest>
+
+// Searches the Unihan token index of the version 2 data file. The installed
+// data file is used if it has the index, otherwise the one of the source tree.
+// The sample of the autotests is too small for meaningful numbers, so without
+// a real version 2 file the benchmark is skipped.
+class KCharSelectDataBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void findUnihan_data();
+    void findUnihan();
+
+private:
+    KCharSelectData m_data;
+};
+
+static QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void KCharSelectDataBenchmark::initTestCase()
+{
+    const QStringList candidates{
+        QStandardPaths::locate(QStandardPaths::GenericDataLocation, QStringLiteral("kf6/kcharselect/kcharselect-data")),
+        QFINDTESTDATA("../src/kcharselect-data"),
+    };
+    for (const QString &fileName : candidates) {
+        if (!fileName.isEmpty() && m_data.loadDataFile(readFile(fileName)) && m_data.unihanIndexSize() > 0) {
+            // nothing is built in memory for the index, the file is all there is
+            qInfo() << "Unihan index of" << fileName << "in bytes:" << m_data.unihanIndexSize();
+            return;
+        }
+    }
+    QSKIP("No version 2 data file with a Unihan index found");
+}
+
+void KCharSelectDataBenchmark::findUnihan_data()
+{
+    QTest::addColumn<QString>("needle");
+    QTest::addColumn<bool>("found");
+
+    // U+4E00 is defined as "one; a, an; alone" and read "jat1" in Cantonese
+    QTest::newRow("definition") << QStringLiteral("alone") << true;
+    QTest::newRow("prefix") << QStringLiteral("alo") << true;
+    QTest::newRow("two words") << QStringLiteral("one alone") << true;
+    QTest::newRow("cantonese") << QStringLiteral("jat1") << true;
+    QTest::newRow("no match") << QStringLiteral("qqqqqq") << false;
+}
+
+void KCharSelectDataBenchmark::findUnihan()
+{
+    QFETCH(QString, needle);
+    QFETCH(bool, found);
+
+    QList<uint> result;
+    QBENCHMARK {
+        result = m_data.find(needle);
+    }
+    QCOMPARE(result.contains(0x4E00), found);
+}
+
+QTEST_GUILESS_MAIN(KCharSelectDataBenchmark)
+
+#include "kcharselectdatabenchmark.moc"
@@ -0,0 +1,35 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KDateComboBox>
+
+#include <QTest>
+#include <QVBoxLayout>
+
+class KDateComboBoxBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void createForm();
+};
+
+// A data-entry form with many date fields, most of which are never opened.
+void KDateComboBoxBenchmark::createForm()
+{
+    QBENCHMARK {
+        QWidget form;
+        auto *layout = new QVBoxLayout(&form);
+        for (int i = 0; i < 30; ++i) {
+            layout->addWidget(new KDateComboBox(&form));
+        }
+    }
+}
+
+QTEST_MAIN(KDateComboBoxBenchmark)
+
+#include "kdatecomboboxbenchmark.moc"
@@ -0,0 +1,65 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KDatePicker>
+
+#include <QPixmap>
+#include <QTest>
+
+// KDateTable is private, it is found as a child of the date picker.
+class KDatePickerBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void paintDateTable();
+    void changeMonth();
+};
+
+static QWidget *dateTable(KDatePicker *picker)
+{
+    const auto children = picker->findChildren<QWidget *>();
+    for (QWidget *child : children) {
+        if (qstrcmp(child->metaObject()->className(), "KDateTable") == 0) {
+            return child;
+        }
+    }
+    return nullptr;
+}
+
+void KDatePickerBenchmark::paintDateTable()
+{
+    KDatePicker picker(QDate(2023, 5, 17));
+    picker.resize(picker.sizeHint());
+    QWidget *table = dateTable(&picker);
+    QVERIFY(table);
+
+    QPixmap pixmap(table->size());
+    QBENCHMARK {
+        table->render(&pixmap);
+    }
+}
+
+void KDatePickerBenchmark::changeMonth()
+{
+    KDatePicker picker(QDate(2023, 5, 17));
+    picker.resize(picker.sizeHint());
+    QWidget *table = dateTable(&picker);
+    QVERIFY(table);
+
+    QPixmap pixmap(table->size());
+    QDate date(2023, 5, 17);
+    QBENCHMARK {
+        date = date.addMonths(1);
+        picker.setDate(date);
+        table->render(&pixmap);
+    }
+}
+
+QTEST_MAIN(KDatePickerBenchmark)
+
+#include "kdatepickerbenchmark.moc"
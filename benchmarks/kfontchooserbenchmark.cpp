@@ -0,0 +1,51 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KFontChooser>
+
+#include <QTest>
+
+class KFontChooserBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void populate_data();
+    void populate();
+    void setFont();
+};
+
+void KFontChooserBenchmark::populate_data()
+{
+    QTest::addColumn<KFontChooser::DisplayFlags>("flags");
+
+    QTest::newRow("default") << KFontChooser::DisplayFlags(KFontChooser::NoDisplayFlags);
+    QTest::newRow("fixed fonts only") << KFontChooser::DisplayFlags(KFontChooser::FixedFontsOnly);
+}
+
+void KFontChooserBenchmark::populate()
+{
+    QFETCH(KFontChooser::DisplayFlags, flags);
+
+    QBENCHMARK {
+        KFontChooser chooser(flags);
+    }
+}
+
+void KFontChooserBenchmark::setFont()
+{
+    KFontChooser chooser;
+    const QFont fonts[] = {QFont(QStringLiteral("Sans Serif"), 10), QFont(QStringLiteral("Monospace"), 12)};
+    int i = 0;
+    QBENCHMARK {
+        chooser.setFont(fonts[i++ % 2]);
+    }
+}
+
+QTEST_MAIN(KFontChooserBenchmark)
+
+#include "kfontchooserbenchmark.moc"
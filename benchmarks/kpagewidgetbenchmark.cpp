@@ -0,0 +1,52 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KPageWidget>
+
+#include <QIcon>
+#include <QTest>
+
+class KPageWidgetBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void addPages_data();
+    void addPages();
+};
+
+void KPageWidgetBenchmark::addPages_data()
+{
+    QTest::addColumn<KPageView::FaceType>("faceType");
+
+    QTest::newRow("list") << KPageView::List;
+    QTest::newRow("tree") << KPageView::Tree;
+    QTest::newRow("tabbed") << KPageView::Tabbed;
+}
+
+// Every added page changes the model layout and makes the navigation view update
+void KPageWidgetBenchmark::addPages()
+{
+    QFETCH(KPageView::FaceType, faceType);
+
+    const QIcon icon = QIcon::fromTheme(QStringLiteral("configure"));
+    QBENCHMARK {
+        KPageWidget pageWidget;
+        pageWidget.setFaceType(faceType);
+        for (int i = 0; i < 10; ++i) {
+            KPageWidgetItem *page = pageWidget.addPage(new QWidget, QStringLiteral("Page %1").arg(i));
+            page->setIcon(icon);
+            for (int j = 0; j < 5; ++j) {
+                pageWidget.addSubPage(page, new QWidget, QStringLiteral("Sub page %1.%2").arg(i).arg(j));
+            }
+        }
+    }
+}
+
+QTEST_MAIN(KPageWidgetBenchmark)
+
+#include "kpagewidgetbenchmark.moc"
@@ -0,0 +1,79 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KPageWidgetModel>
+
+#include <QTest>
+
+class KPageWidgetModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void index();
+    void itemData();
+    void item();
+
+private:
+    KPageWidgetModel *m_model = nullptr;
+};
+
+void KPageWidgetModelBenchmark::initTestCase()
+{
+    m_model = new KPageWidgetModel(this);
+    for (int i = 0; i < 50; ++i) {
+        KPageWidgetItem *page = m_model->addPage(new QWidget, QStringLiteral("Page %1").arg(i));
+        for (int j = 0; j < 10; ++j) {
+            m_model->addSubPage(page, new QWidget, QStringLiteral("Sub page %1.%2").arg(i).arg(j));
+        }
+    }
+}
+
+void KPageWidgetModelBenchmark::cleanupTestCase()
+{
+    delete m_model;
+    m_model = nullptr;
+}
+
+void KPageWidgetModelBenchmark::index()
+{
+    QBENCHMARK {
+        const int rows = m_model->rowCount();
+        for (int row = 0; row < rows; ++row) {
+            const QModelIndex parent = m_model->index(row, 0);
+            const int childRows = m_model->rowCount(parent);
+            for (int childRow = 0; childRow < childRows; ++childRow) {
+                QVERIFY(m_model->index(childRow, 0, parent).isValid());
+            }
+        }
+    }
+}
+
+void KPageWidgetModelBenchmark::itemData()
+{
+    const QModelIndex index = m_model->index(2, 0, m_model->index(25, 0));
+    QBENCHMARK {
+        m_model->data(index, Qt::DisplayRole);
+        m_model->data(index, Qt::DecorationRole);
+        m_model->data(index, KPageModel::HeaderRole);
+    }
+}
+
+void KPageWidgetModelBenchmark::item()
+{
+    const QModelIndex index = m_model->index(9, 0, m_model->index(49, 0));
+    QBENCHMARK {
+        QVERIFY(m_model->item(index));
+        QVERIFY(m_model->index(m_model->item(index)).isValid());
+    }
+}
+
+QTEST_MAIN(KPageWidgetModelBenchmark)
+
+#include "kpagewidgetmodelbenchmark.moc"
@@ -0,0 +1,52 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KRatingPainter>
+
+#include <QImage>
+#include <QPainter>
+#include <QTest>
+
+class KRatingPainterBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void paint_data();
+    void paint();
+};
+
+void KRatingPainterBenchmark::paint_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("hoverRating");
+
+    QTest::newRow("small") << QSize(80, 16) << -1;
+    QTest::newRow("small hovered") << QSize(80, 16) << 7;
+    QTest::newRow("large") << QSize(320, 64) << -1;
+    QTest::newRow("large hovered") << QSize(320, 64) << 3;
+}
+
+void KRatingPainterBenchmark::paint()
+{
+    QFETCH(QSize, size);
+    QFETCH(int, hoverRating);
+
+    KRatingPainter ratingPainter;
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+
+    int rating = 0;
+    QBENCHMARK {
+        ratingPainter.paint(&painter, image.rect(), rating, hoverRating);
+        rating = (rating + 1) % (ratingPainter.maxRating() + 1);
+    }
+}
+
+QTEST_MAIN(KRatingPainterBenchmark)
+
+#include "kratingpainterbenchmark.moc"
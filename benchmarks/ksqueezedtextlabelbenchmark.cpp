@@ -0,0 +1,53 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <KSqueezedTextLabel>
+
+#include <QTest>
+
+class KSqueezedTextLabelBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void resize_data();
+    void resize();
+};
+
+void KSqueezedTextLabelBenchmark::resize_data()
+{
+    QTest::addColumn<Qt::TextElideMode>("mode");
+
+    QTest::newRow("elide left") << Qt::ElideLeft;
+    QTest::newRow("elide middle") << Qt::ElideMiddle;
+    QTest::newRow("elide right") << Qt::ElideRight;
+}
+
+void KSqueezedTextLabelBenchmark::resize()
+{
+    QFETCH(Qt::TextElideMode, mode);
+
+    QStringList lines;
+    for (int i = 0; i < 20; ++i) {
+        lines << QStringLiteral("/home/user/Documents/Projects/kwidgetsaddons/src/some/deeply/nested/directory/file%1.cpp").arg(i);
+    }
+
+    KSqueezedTextLabel label;
+    label.setTextElideMode(mode);
+    label.setText(lines.join(QLatin1Char('\n')));
+    label.show();
+
+    int width = 100;
+    QBENCHMARK {
+        label.resize(width, label.height());
+        width = width >= 600 ? 100 : width + 10;
+    }
+}
+
+QTEST_MAIN(KSqueezedTextLabelBenchmark)
+
+#include "ksqueezedtextlabelbenchmark.moc"
@@ -7,6 +7,8 @@
 
 #include <common_helpers_p.h>
 
+#include <QVarLengthArray>
+
 // If pos points to alphanumeric X in "...(X)...", which is preceded or
 // followed only by non-alphanumerics, then "(X)" gets removed.
 static QString removeReducedCJKAccMark(const QString &label, int pos)
@@ -38,58 +40,131 @@ static QString removeReducedCJKAccMark(const QString &label, int pos)
     return label;
 }
 
-QString removeAcceleratorMarker(const QString &label_)
+// If there are CJK characters in the label, try to remove reduced CJK
+// markers "(X)" from it.
+static QString removeReducedCJKAccMarks(const QString &label_)
 {
-    QString label = label_;
+    bool hasCJK = false;
+    for (const QChar c : label_) {
+        if (c.unicode() >= 0x2e00) { // rough, but should be sufficient
+            hasCJK = true;
+            break;
+        }
+    }
+    if (!hasCJK) {
+        return label_;
+    }
 
+    QString label = label_;
     int p = 0;
-    bool accmarkRemoved = false;
     while (true) {
-        p = label.indexOf(QLatin1Char('&'), p);
-        if (p < 0 || p + 1 == label.length()) {
+        p = label.indexOf(QLatin1Char('('), p);
+        if (p < 0) {
             break;
         }
+        label = removeReducedCJKAccMark(label, p + 1);
+        ++p;
+    }
+    return label;
+}
 
-        if (label.at(p + 1).isLetterOrNumber()) {
-            // Valid accelerator.
-            label.remove(p, 1);
-
-            // May have been an accelerator in CJK-style "(&X)"
-            // at the start or end of text.
-            label = removeReducedCJKAccMark(label, p);
+static bool isAcceleratorCharacter(QChar c, AcceleratorKind kind)
+{
+    switch (kind) {
+    case AcceleratorKind::LetterOrNumber:
+        return c.isLetterOrNumber();
+    case AcceleratorKind::Printable:
+        return c.isPrint();
+    case AcceleratorKind::AnyCharacter:
+        return true;
+    }
+    return false;
+}
 
-            accmarkRemoved = true;
-        } else if (label.at(p + 1) == QLatin1Char('&')) {
+qsizetype findAcceleratorMarker(QStringView label, AcceleratorKind kind)
+{
+    const qsizetype len = label.size();
+    for (qsizetype p = label.indexOf(QLatin1Char('&')); p >= 0 && p + 1 < len; p = label.indexOf(QLatin1Char('&'), p + 1)) {
+        if (label[p + 1] == QLatin1Char('&')) {
             // Escaped accelerator marker.
-            label.remove(p, 1);
+            ++p;
+        } else if (isAcceleratorCharacter(label[p + 1], kind)) {
+            return p;
         }
-
-        ++p;
     }
+    return -1;
+}
 
-    // If no marker was removed, and there are CJK characters in the label,
-    // also try to remove reduced CJK marker -- something may have removed
-    // ampersand beforehand.
-    if (!accmarkRemoved) {
-        bool hasCJK = false;
-        for (const QChar c : std::as_const(label)) {
-            if (c.unicode() >= 0x2e00) { // rough, but should be sufficient
-                hasCJK = true;
-                break;
+// Single pass over the label, copying the chunks between markers.
+// If acceleratorPositions is given, the positions of the accelerator
+// characters in the result get appended to it.
+static QString stripMarkers(QStringView label, AcceleratorKind kind, QVarLengthArray<qsizetype, 4> *acceleratorPositions)
+{
+    const qsizetype len = label.size();
+    QString result;
+    result.reserve(len);
+
+    qsizetype start = 0;
+    for (qsizetype p = label.indexOf(QLatin1Char('&')); p >= 0; p = label.indexOf(QLatin1Char('&'), p + 1)) {
+        if (p + 1 == len) {
+            // Trailing ampersand.
+            if (kind == AcceleratorKind::AnyCharacter) {
+                result.append(label.mid(start, p - start));
+                start = len;
             }
+            break;
         }
-        if (hasCJK) {
-            p = 0;
-            while (true) {
-                p = label.indexOf(QLatin1Char('('), p);
-                if (p < 0) {
-                    break;
-                }
-                label = removeReducedCJKAccMark(label, p + 1);
-                ++p;
+
+        if (label[p + 1] == QLatin1Char('&')) {
+            // Escaped accelerator marker, keep one ampersand.
+            result.append(label.mid(start, p + 1 - start));
+            start = p + 2;
+            ++p;
+        } else if (isAcceleratorCharacter(label[p + 1], kind)) {
+            result.append(label.mid(start, p - start));
+            start = p + 1;
+            if (acceleratorPositions) {
+                acceleratorPositions->append(result.size());
             }
         }
     }
+    result.append(label.mid(start));
+
+    return result;
+}
+
+QString stripAcceleratorMarkers(QStringView label, AcceleratorKind kind)
+{
+    return stripMarkers(label, kind, nullptr);
+}
+
+QString stripAcceleratorMarkers(const QString &label, AcceleratorKind kind)
+{
+    if (!label.contains(QLatin1Char('&'))) {
+        return label;
+    }
+    return stripMarkers(label, kind, nullptr);
+}
+
+QString removeAcceleratorMarker(const QString &label_)
+{
+    if (!label_.contains(QLatin1Char('&'))) {
+        // Nothing to strip, but something may have removed the ampersand
+        // of a CJK marker beforehand.
+        return removeReducedCJKAccMarks(label_);
+    }
+
+    QVarLengthArray<qsizetype, 4> acceleratorPositions;
+    QString label = stripMarkers(label_, AcceleratorKind::LetterOrNumber, &acceleratorPositions);
+    if (acceleratorPositions.isEmpty()) {
+        return removeReducedCJKAccMarks(label);
+    }
+
+    // May have been accelerators in CJK-style "(&X)" at the start or end of text.
+    // Going backwards keeps the positions of the preceding accelerators valid.
+    for (auto it = acceleratorPositions.crbegin(); it != acceleratorPositions.crend(); ++it) {
+        label = removeReducedCJKAccMark(label, *it);
+    }
 
     return label;
 }
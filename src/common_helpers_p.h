@@ -14,6 +14,42 @@
 // Standalone (pure Qt) functionality needed internally in more than
 // one source file on localization.
 
+/**
+ * @internal
+ *
+ * Which characters following an ampersand turn it into an accelerator marker.
+ */
+enum class AcceleratorKind {
+    LetterOrNumber, ///< Only letters and numbers, as used by removeAcceleratorMarker()
+    Printable, ///< Any printable character, as used by QAccel
+    AnyCharacter, ///< Any character, every single ampersand is a marker
+};
+
+/**
+ * @internal
+ *
+ * Returns the position of the first accelerator marker in @p label,
+ * skipping escaped markers ("&&"), or -1 if there is none.
+ */
+qsizetype findAcceleratorMarker(QStringView label, AcceleratorKind kind);
+
+/**
+ * @internal
+ *
+ * Removes all accelerator markers from @p label in a single pass and
+ * resolves escaped markers ("&&") to a plain ampersand.
+ * Unlike removeAcceleratorMarker(), CJK-style markers are left alone.
+ */
+QString stripAcceleratorMarkers(QStringView label, AcceleratorKind kind);
+
+/**
+ * @internal
+ *
+ * Same as stripAcceleratorMarkers(), but returns @p label itself
+ * when it has no ampersand.
+ */
+QString stripAcceleratorMarkers(const QString &label, AcceleratorKind kind);
+
 /**
  * @internal
  *
@@ -13,6 +13,7 @@
 #include <QComboBox>
 #include <QDockWidget>
 #include <QGroupBox>
+#include <QHash>
 #include <QLabel>
 #include <QLineEdit>
 #include <QList>
@@ -22,12 +23,17 @@
 #include <QObject>
 #include <QPushButton>
 #include <QRadioButton>
+#include <QSemaphore>
 #include <QStackedWidget>
 #include <QTabBar>
 #include <QTextEdit>
+#include <QThreadPool>
 #include <QWidget>
 
+#include <algorithm>
+
 #include "common_helpers_p.h"
+#include "ktracing_p.h"
 #include "loggingcategory.h"
 
 /*********************************************************************
@@ -49,6 +55,8 @@ QStringList KAcceleratorManagerPrivate::standardNames;
 void KAcceleratorManagerPrivate::addStandardActionNames(const QStringList &list)
 {
     standardNames.append(list);
+    // standard names get a higher weight, so earlier distributions may be outdated
+    KAccelManagerAlgorithm::clearCache();
 }
 
 bool KAcceleratorManagerPrivate::standardName(const QString &str)
@@ -92,18 +100,26 @@ void KAcceleratorManagerPrivate::manage(QWidget *widget)
         return;
     }
 
+    KTRACE_SCOPE("KAcceleratorManager::manage");
     Item *root = new Item;
 
     QString used;
     manageWidget(widget, root, used);
-    calculateAccelerators(root, used);
+    if (calculateAccelerators(root, used)) {
+        // write back all the changed texts at once, so that the widgets are
+        // repainted once at the end instead of after every single change
+        const bool updatesEnabled = widget->updatesEnabled();
+        widget->setUpdatesEnabled(false);
+        applyAccelerators(root);
+        widget->setUpdatesEnabled(updatesEnabled);
+    }
     delete root;
 }
 
-void KAcceleratorManagerPrivate::calculateAccelerators(Item *item, QString &used)
+bool KAcceleratorManagerPrivate::calculateAccelerators(Item *item, QString &used)
 {
     if (!item->m_children) {
-        return;
+        return false;
     }
 
     // collect the contents
@@ -116,62 +132,63 @@ void KAcceleratorManagerPrivate::calculateAccelerators(Item *item, QString &used
     // find the right accelerators
     KAccelManagerAlgorithm::findAccelerators(contents, used);
 
-    // write them back into the widgets
+    // remember the changed texts, applyAccelerators() writes them into the widgets
+    bool changed = false;
     int cnt = -1;
     for (Item *it : std::as_const(*item->m_children)) {
         cnt++;
 
-        QDockWidget *dock = qobject_cast<QDockWidget *>(it->m_widget);
-        if (dock) {
-            if (checkChange(contents[cnt])) {
-                dock->setWindowTitle(contents[cnt].accelerated());
-            }
-            continue;
-        }
-        QTabBar *tabBar = qobject_cast<QTabBar *>(it->m_widget);
-        if (tabBar) {
-            if (checkChange(contents[cnt])) {
-                tabBar->setTabText(it->m_index, contents[cnt].accelerated());
-            }
-            continue;
-        }
-        QMenuBar *menuBar = qobject_cast<QMenuBar *>(it->m_widget);
-        if (menuBar) {
-            if (it->m_index >= 0) {
-                QAction *maction = menuBar->actions()[it->m_index];
-                if (maction) {
-                    checkChange(contents[cnt]);
-                    maction->setText(contents[cnt].accelerated());
-                }
-                continue;
-            }
-        }
-
-        // we possibly reserved an accel, but we won't set it as it looks silly
-        QGroupBox *groupBox = qobject_cast<QGroupBox *>(it->m_widget);
-        if (groupBox && !groupBox->isCheckable()) {
+        if (it->m_kind == Item::ReservedOnly) {
             continue;
         }
 
-        int tprop = it->m_widget->metaObject()->indexOfProperty("text");
-        if (tprop != -1) {
-            if (checkChange(contents[cnt])) {
-                it->m_widget->setProperty("text", contents[cnt].accelerated());
-            }
-        } else {
-            tprop = it->m_widget->metaObject()->indexOfProperty("title");
-            if (tprop != -1 && checkChange(contents[cnt])) {
-                it->m_widget->setProperty("title", contents[cnt].accelerated());
-            }
+        if (checkChange(contents[cnt])) {
+            it->m_accelerated = contents[cnt].accelerated();
+            it->m_changed = true;
+            changed = true;
         }
     }
 
     // calculate the accelerators for the children
     for (Item *it : std::as_const(*item->m_children)) {
         if (it->m_widget && it->m_widget->isVisibleTo(item->m_widget)) {
-            calculateAccelerators(it, used);
+            changed |= calculateAccelerators(it, used);
         }
     }
+
+    return changed;
+}
+
+void KAcceleratorManagerPrivate::applyAccelerators(Item *item)
+{
+    if (!item->m_children) {
+        return;
+    }
+
+    for (Item *it : std::as_const(*item->m_children)) {
+        if (it->m_changed) {
+            switch (it->m_kind) {
+            case Item::Property:
+                it->m_widget->metaObject()->property(it->m_property).write(it->m_widget, it->m_accelerated);
+                break;
+            case Item::DockWidgetTitle:
+                it->m_widget->setWindowTitle(it->m_accelerated);
+                break;
+            case Item::TabBarTab:
+                static_cast<QTabBar *>(it->m_widget)->setTabText(it->m_index, it->m_accelerated);
+                break;
+            case Item::MenuBarAction:
+                if (QAction *maction = it->m_widget->actions().value(it->m_index)) {
+                    maction->setText(it->m_accelerated);
+                }
+                break;
+            case Item::ReservedOnly:
+                break;
+            }
+        }
+
+        applyAccelerators(it);
+    }
 }
 
 void KAcceleratorManagerPrivate::traverseChildren(QWidget *widget, Item *item, QString &used)
@@ -325,6 +342,11 @@ void KAcceleratorManagerPrivate::manageWidget(QWidget *w, Item *item, QString &u
             }
 
             i->m_content = KAccelString(content, weight);
+            i->m_property = tprop;
+            // we possibly reserve an accel for non-checkable group boxes, but we won't set it as it looks silly
+            if (groupBox && !groupBox->isCheckable()) {
+                i->m_kind = Item::ReservedOnly;
+            }
             item->addChild(i);
         }
     }
@@ -355,6 +377,7 @@ void KAcceleratorManagerPrivate::manageTabBar(QTabBar *bar, Item *item)
         item->addChild(it);
         it->m_widget = bar;
         it->m_index = i;
+        it->m_kind = Item::TabBarTab;
         it->m_content = KAccelString(content);
     }
 }
@@ -379,6 +402,7 @@ void KAcceleratorManagerPrivate::manageDockWidget(QDockWidget *dock, Item *item)
     Item *it = new Item;
     item->addChild(it);
     it->m_widget = dock;
+    it->m_kind = Item::DockWidgetTitle;
     it->m_content = KAccelString(content, KAccelManagerAlgorithm::STANDARD_ACCEL);
 }
 
@@ -407,6 +431,7 @@ void KAcceleratorManagerPrivate::manageMenuBar(QMenuBar *mbar, Item *item)
 
             it->m_widget = mbar;
             it->m_index = i;
+            it->m_kind = Item::MenuBarAction;
         }
 
         // have a look at the popup as well, if present
@@ -472,10 +497,7 @@ KAccelString::KAccelString(const QString &input, int initialWeight)
     if (initialWeight == -1) {
         initialWeight = KAccelManagerAlgorithm::DEFAULT_WEIGHT;
     }
-
-    calculateWeights(initialWeight);
-
-    // dump();
+    m_initialWeight = initialWeight;
 }
 
 QString KAccelString::accelerated() const
@@ -519,7 +541,7 @@ QChar KAccelString::accelerator() const
     return m_pureText[m_accel].toLower();
 }
 
-void KAccelString::calculateWeights(int initialWeight)
+void KAccelString::calculateWeights() const
 {
     m_weight.resize(m_pureText.length());
 
@@ -529,7 +551,7 @@ void KAccelString::calculateWeights(int initialWeight)
     while (pos < m_pureText.length()) {
         QChar c = m_pureText[pos];
 
-        int weight = initialWeight + 1;
+        int weight = m_initialWeight + 1;
 
         // add special weight to first character
         if (pos == 0) {
@@ -548,7 +570,7 @@ void KAccelString::calculateWeights(int initialWeight)
         }
 
         // try to preserve the wanted accelerators
-        if (pos == accel()) {
+        if (pos == m_orig_accel) {
             weight += KAccelManagerAlgorithm::WANTED_ACCEL_EXTRA_WEIGHT;
             // qCDebug(KWidgetsAddonsLog) << "wanted " << m_pureText << " " << KAcceleratorManagerPrivate::standardName(m_origText);
             if (KAcceleratorManagerPrivate::standardName(m_origText)) {
@@ -571,27 +593,12 @@ void KAccelString::calculateWeights(int initialWeight)
 int KAccelString::stripAccelerator(QString &text)
 {
     // Note: this code is derived from QAccel::shortcutKey
-    int p = 0;
-
-    while (p >= 0) {
-        p = text.indexOf(QLatin1Char('&'), p) + 1;
-
-        if (p <= 0 || p >= text.length()) {
-            break;
-        }
-
-        if (text[p] != QLatin1Char('&')) {
-            QChar c = text[p];
-            if (c.isPrint()) {
-                text.remove(p - 1, 1);
-                return p - 1;
-            }
-        }
-
-        p++;
+    // Escaped markers are kept, the positions refer to the original text
+    const qsizetype p = findAcceleratorMarker(text, AcceleratorKind::Printable);
+    if (p >= 0) {
+        text.remove(p, 1);
     }
-
-    return -1;
+    return p;
 }
 
 int KAccelString::maxWeight(int &index, const QString &used) const
@@ -599,6 +606,8 @@ int KAccelString::maxWeight(int &index, const QString &used) const
     int max = 0;
     index = -1;
 
+    ensureWeights();
+
     for (int pos = 0; pos < m_pureText.length(); ++pos) {
         if (used.indexOf(m_pureText[pos], 0, Qt::CaseInsensitive) == -1 && m_pureText[pos].toLatin1() != 0) {
             if (m_weight[pos] > max) {
@@ -613,6 +622,8 @@ int KAccelString::maxWeight(int &index, const QString &used) const
 
 void KAccelString::dump()
 {
+    ensureWeights();
+
     QString s;
     for (int i = 0; i < m_weight.count(); ++i) {
         s += QStringLiteral("%1(%2) ").arg(pure()[i]).arg(m_weight[i]);
@@ -653,7 +664,71 @@ void KAccelString::dump()
 
  *********************************************************************/
 
-void KAccelManagerAlgorithm::findAccelerators(KAccelStringList &result, QString &used)
+namespace
+{
+struct AcceleratorDistribution {
+    QList<int> accels;
+    QString used;
+};
+
+// The distribution only depends on the texts, their initial weights and the
+// accelerators already in use, so a dialog page or a menu which is shown
+// again gets its accelerators without running the algorithm again.
+struct AcceleratorCache {
+    QHash<QString, AcceleratorDistribution> distributions;
+    int hits = 0;
+    int misses = 0;
+};
+
+Q_GLOBAL_STATIC(AcceleratorCache, s_acceleratorCache)
+
+// plenty for the pages and menus of an application's windows
+constexpr int MaxCachedDistributions = 256;
+
+QString distributionKey(const KAccelStringList &strings, const QString &used)
+{
+    QString key = used;
+    for (const KAccelString &string : strings) {
+        key += QLatin1Char('\x1e') + QString::number(string.initialWeight()) + QLatin1Char('\x1f') + string.originalText();
+    }
+    return key;
+}
+
+// below this many texts, handing the weights to other threads costs more than it saves
+constexpr int DefaultMinParallelWeights = 256;
+int minParallelWeights = DefaultMinParallelWeights;
+
+void calculateWeightsInParallel(const KAccelStringList &strings)
+{
+    KTRACE_SCOPE("KAccelManagerAlgorithm::calculateWeightsInParallel");
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int count = strings.size();
+    const int chunks = std::clamp(count / std::max(1, minParallelWeights / 2), 1, pool->maxThreadCount() + 1);
+
+    QSemaphore finished;
+    for (int chunk = 1; chunk < chunks; ++chunk) {
+        const int begin = count * chunk / chunks;
+        const int end = count * (chunk + 1) / chunks;
+        auto task = [&strings, &finished, begin, end]() {
+            for (int i = begin; i < end; ++i) {
+                strings.at(i).ensureWeights();
+            }
+            finished.release();
+        };
+        // never wait for a busy pool, do the work here instead
+        if (!pool->tryStart(task)) {
+            task();
+        }
+    }
+
+    for (int i = 0, end = count / chunks; i < end; ++i) {
+        strings.at(i).ensureWeights();
+    }
+    finished.acquire(chunks - 1);
+}
+
+void distributeAccelerators(KAccelStringList &result, QString &used)
 {
     KAccelStringList accel_strings = result;
 
@@ -694,6 +769,65 @@ void KAccelManagerAlgorithm::findAccelerators(KAccelStringList &result, QString
         accel_strings[index] = KAccelString();
     }
 }
+}
+
+void KAccelManagerAlgorithm::findAccelerators(KAccelStringList &result, QString &used)
+{
+    AcceleratorCache *cache = s_acceleratorCache();
+    const QString key = distributionKey(result, used);
+
+    const auto it = cache->distributions.constFind(key);
+    if (it != cache->distributions.cend()) {
+        ++cache->hits;
+        KTRACE_COUNT("KAcceleratorManager cache hits");
+        for (int i = 0; i < result.count(); ++i) {
+            result[i].setAccel(it->accels.at(i));
+        }
+        used = it->used;
+        return;
+    }
+
+    ++cache->misses;
+    KTRACE_COUNT("KAcceleratorManager cache misses");
+    if (result.size() >= minParallelWeights) {
+        // the distribution itself has to stay sequential, every pick
+        // depends on the accelerators used by the previous ones
+        calculateWeightsInParallel(result);
+    }
+    distributeAccelerators(result, used);
+
+    AcceleratorDistribution distribution;
+    distribution.accels.reserve(result.count());
+    for (const KAccelString &string : std::as_const(result)) {
+        distribution.accels.append(string.accel());
+    }
+    distribution.used = used;
+
+    if (cache->distributions.size() >= MaxCachedDistributions) {
+        cache->distributions.clear();
+    }
+    cache->distributions.insert(key, distribution);
+}
+
+int KAccelManagerAlgorithm::cacheHits()
+{
+    return s_acceleratorCache()->hits;
+}
+
+int KAccelManagerAlgorithm::cacheMisses()
+{
+    return s_acceleratorCache()->misses;
+}
+
+void KAccelManagerAlgorithm::clearCache()
+{
+    s_acceleratorCache()->distributions.clear();
+}
+
+void KAccelManagerAlgorithm::setMinParallelWeights(int count)
+{
+    minParallelWeights = count < 0 ? DefaultMinParallelWeights : count;
+}
 
 /*********************************************************************
 
@@ -733,6 +867,7 @@ void KPopupAccelManager::aboutToShow()
 
 void KPopupAccelManager::calculateAccelerators()
 {
+    KTRACE_SCOPE("KPopupAccelManager::calculateAccelerators");
     // find the new accelerators
     QString used;
     KAccelManagerAlgorithm::findAccelerators(m_entries, used);
@@ -12,6 +12,8 @@
 #include <QObject>
 #include <QString>
 
+#include <kwidgetsaddons_export.h>
+
 class QStackedWidget;
 class QMenu;
 class QMenuBar;
@@ -23,7 +25,8 @@ class QDockWidget;
  *
  * This class contains a string and knowledge about accelerators.
  * It keeps a list weights, telling how valuable each character
- * would be as an accelerator.
+ * would be as an accelerator. The weights are only calculated
+ * when they are first needed.
  *
  * @author Matthias Hölzer-Klüpfel <mhk@kde.org>
  */
@@ -39,8 +42,6 @@ public:
     }
     explicit KAccelString(const QString &input, int initalWeight = -1);
 
-    void calculateWeights(int initialWeight);
-
     const QString &pure() const
     {
         return m_pureText;
@@ -67,8 +68,24 @@ public:
 
     QChar accelerator() const;
 
+    int initialWeight() const
+    {
+        return m_initialWeight;
+    }
+
     int maxWeight(int &index, const QString &used) const;
 
+    /**
+     * Calculates the weights now instead of on the first maxWeight() call.
+     * Different strings can do this concurrently.
+     */
+    void ensureWeights() const
+    {
+        if (m_weight.size() != m_pureText.size()) {
+            calculateWeights();
+        }
+    }
+
     bool operator==(const KAccelString &c) const
     {
         return m_pureText == c.m_pureText && m_accel == c.m_accel && m_orig_accel == c.m_orig_accel;
@@ -76,6 +93,7 @@ public:
 
 private:
     int stripAccelerator(QString &input);
+    void calculateWeights() const;
 
     void dump();
 
@@ -83,7 +101,8 @@ private:
     QString m_origText;
     int m_accel;
     int m_orig_accel;
-    QList<int> m_weight;
+    int m_initialWeight = 0;
+    mutable QList<int> m_weight;
 };
 
 typedef QList<KAccelString> KAccelStringList;
@@ -95,7 +114,8 @@ typedef QList<KAccelString> KAccelStringList;
  * @author Matthias Hölzer-Klüpfel <mhk@kde.org>
  */
 
-class KAccelManagerAlgorithm
+// exported for the unit tests and benchmarks, which check the cache
+class KWIDGETSADDONS_EXPORT KAccelManagerAlgorithm
 {
 public:
     enum {
@@ -122,6 +142,20 @@ public:
     };
 
     static void findAccelerators(KAccelStringList &result, QString &used);
+
+    /**
+     * Number of findAccelerators() calls answered from the cache of
+     * previous distributions, resp. computed from scratch.
+     */
+    static int cacheHits();
+    static int cacheMisses();
+    static void clearCache();
+
+    /**
+     * Sets the least number of strings whose weights are calculated on
+     * several threads, -1 restores the default. Only meant for the tests.
+     */
+    static void setMinParallelWeights(int count);
 };
 
 /**
@@ -234,11 +268,24 @@ private:
     static void manageTabBar(QTabBar *bar, Item *item);
     static void manageDockWidget(QDockWidget *dock, Item *item);
 
-    static void calculateAccelerators(Item *item, QString &used);
+    static bool calculateAccelerators(Item *item, QString &used);
+    static void applyAccelerators(Item *item);
 
     class Item
     {
     public:
+        /**
+         * Where the text of the item comes from and has to be written back to,
+         * resolved once while building the tree.
+         */
+        enum Kind {
+            Property, ///< the "text" or "title" property m_property of m_widget
+            DockWidgetTitle, ///< the window title of the QDockWidget m_widget
+            TabBarTab, ///< the text of tab m_index of the QTabBar m_widget
+            MenuBarAction, ///< the text of action m_index of the QMenuBar m_widget
+            ReservedOnly, ///< takes part in the distribution, but is not written back
+        };
+
         Item()
             : m_widget(nullptr)
             , m_children(nullptr)
@@ -256,6 +303,10 @@ private:
         KAccelString m_content;
         ItemList *m_children;
         int m_index;
+        Kind m_kind = Property;
+        int m_property = -1;
+        bool m_changed = false;
+        QString m_accelerated;
     };
 };
 
@@ -5,6 +5,7 @@
 */
 
 #include "kbusyindicatorwidget.h"
+#include "ktracing_p.h"
 
 #include <QApplication>
 #include <QIcon>
@@ -24,6 +25,7 @@ public:
         animation.setStartValue(0);
         animation.setEndValue(360);
         QObject::connect(&animation, &QVariantAnimation::valueChanged, q, [=](QVariant value) {
+            KTRACE_COUNT("KBusyIndicatorWidget animation ticks");
             rotation = value.toReal();
             q->update(); // repaint new rotation
         });
@@ -0,0 +1,153 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kcalendarmonth_p.h"
+
+#include <QHash>
+
+namespace
+{
+struct MonthKey {
+    int year;
+    int month;
+    QLocale locale;
+
+    bool operator==(const MonthKey &other) const
+    {
+        return year == other.year && month == other.month && locale == other.locale;
+    }
+};
+
+size_t qHash(const MonthKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.year, key.month, key.locale);
+}
+
+// The months currently in use. The widgets own them, so a month is dropped
+// once no widget shows it anymore.
+QHash<MonthKey, std::weak_ptr<const KCalendarMonth>> &monthCache()
+{
+    static QHash<MonthKey, std::weak_ptr<const KCalendarMonth>> cache;
+    return cache;
+}
+}
+
+std::shared_ptr<const KCalendarMonth> KCalendarMonth::get(int year, int month, const QLocale &locale)
+{
+    auto &cache = monthCache();
+    const MonthKey key{year, month, locale};
+
+    if (std::shared_ptr<const KCalendarMonth> calendarMonth = cache.value(key).lock()) {
+        return calendarMonth;
+    }
+
+    // forget about the months nobody uses anymore before adding a new one
+    if (cache.size() >= 32) {
+        for (auto it = cache.begin(); it != cache.end();) {
+            if (it.value().expired()) {
+                it = cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::shared_ptr<const KCalendarMonth> calendarMonth(new KCalendarMonth(year, month, locale));
+    cache.insert(key, calendarMonth);
+    return calendarMonth;
+}
+
+QList<KCalendarMonth::Week> KCalendarMonth::weeksOfYear(int year)
+{
+    // week numbers do not depend on the locale and the lists are small, so keep them all
+    static QHash<int, QList<Week>> cache;
+
+    auto it = cache.find(year);
+    if (it != cache.end()) {
+        return *it;
+    }
+
+    QList<Week> weeks;
+    QDate day(year, 1, 1);
+    const QDate lastDayOfYear = QDate(year + 1, 1, 1).addDays(-1);
+
+    // Starting from the first day in the year, loop through the year a week at a time
+    for (; day.isValid() && day <= lastDayOfYear; day = day.addDays(7)) {
+        // Get the ISO week number for the current day and what year that week is in
+        // e.g. 1st day of this year may fall in week 53 of previous year
+        int weekYear = year;
+        const int week = day.weekNumber(&weekYear);
+        weeks.append({day, week, weekYear});
+
+        // make sure that the week of the lastDayOfYear is always inserted: in Chinese calendar
+        // system, this is not always the case
+        if (day < lastDayOfYear //
+            && day.daysTo(lastDayOfYear) < 7 //
+            && lastDayOfYear.weekNumber() != day.weekNumber()) {
+            day = lastDayOfYear.addDays(-7);
+        }
+    }
+
+    cache.insert(year, weeks);
+    return weeks;
+}
+
+KCalendarMonth::KCalendarMonth(int year, int month, const QLocale &locale)
+    : m_locale(locale)
+    , m_firstOfMonth(year, month, 1)
+{
+    const int firstDayOfWeek = locale.firstDayOfWeek();
+
+    m_leadingDays = (m_firstOfMonth.dayOfWeek() - firstDayOfWeek + Columns) % Columns;
+    // make sure at least one day of the previous month is visible.
+    // adjust this < 1 if more days should be forced visible:
+    if (m_leadingDays < 1) {
+        m_leadingDays += Columns;
+    }
+
+    for (int position = 0; position < Cells; ++position) {
+        m_dates[position] = m_firstOfMonth.addDays(position - m_leadingDays);
+        if (m_dates[position].isValid()) {
+            m_dayLabels[position] = locale.toString(m_dates[position].day());
+        }
+    }
+
+    for (int row = 0; row < Rows; ++row) {
+        m_weekNumbers[row] = m_dates[row * Columns].weekNumber();
+    }
+
+    const QList<Qt::DayOfWeek> weekdays = locale.weekdays();
+    for (int column = 0; column < Columns; ++column) {
+        Column &c = m_columns[column];
+        c.weekDay = (column + firstDayOfWeek - 1) % Columns + 1;
+        c.shortDayName = locale.dayName(c.weekDay, QLocale::ShortFormat);
+        if (!weekdays.isEmpty()) {
+            if (weekdays.first() <= weekdays.last()) {
+                c.workingDay = c.weekDay >= weekdays.first() && c.weekDay <= weekdays.last();
+            } else {
+                c.workingDay = c.weekDay >= weekdays.first() || c.weekDay <= weekdays.last();
+            }
+        }
+    }
+}
+
+QDate KCalendarMonth::date(int position) const
+{
+    if (position >= 0 && position < Cells) {
+        return m_dates[position];
+    }
+    return m_firstOfMonth.addDays(position - m_leadingDays);
+}
+
+QString KCalendarMonth::dayLabel(int position) const
+{
+    if (position >= 0 && position < Cells) {
+        return m_dayLabels[position];
+    }
+    const QDate cellDate = date(position);
+    return cellDate.isValid() ? m_locale.toString(cellDate.day()) : QString();
+}
@@ -0,0 +1,141 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KCALENDARMONTH_P_H
+#define KCALENDARMONTH_P_H
+
+#include <QDate>
+#include <QList>
+#include <QLocale>
+#include <QString>
+
+#include <array>
+#include <memory>
+
+/**
+ * @internal
+ * The layout of one month in a date table, as shown by KDateTable and with it
+ * KDatePicker, KDatePickerPopup, KDateComboBox and KDateTimeEdit.
+ *
+ * The cell dates, their labels, the week numbers of the rows and the weekday
+ * names of the columns are computed once and shared by all widgets showing the
+ * same month in the same locale, as long as any of them holds on to it.
+ *
+ * Only to be used from the GUI thread.
+ */
+class KCalendarMonth
+{
+public:
+    enum {
+        Columns = 7,
+        Rows = 6,
+        Cells = Columns * Rows,
+    };
+
+    /**
+     * One week of a year, as listed by the week selector of KDatePicker.
+     */
+    struct Week {
+        QDate firstDay; ///< the first day of the year in this week
+        int number; ///< the ISO 8601 week number
+        int year; ///< the year the week number belongs to
+    };
+
+    /**
+     * Returns the shared layout of @p month of @p year in @p locale.
+     */
+    static std::shared_ptr<const KCalendarMonth> get(int year, int month, const QLocale &locale);
+
+    /**
+     * Returns the weeks of @p year, starting with the week of January 1st.
+     */
+    static QList<Week> weeksOfYear(int year);
+
+    int year() const
+    {
+        return m_firstOfMonth.year();
+    }
+    int month() const
+    {
+        return m_firstOfMonth.month();
+    }
+    const QLocale &locale() const
+    {
+        return m_locale;
+    }
+
+    /**
+     * Returns the date shown in cell @p position, counted row by row from the
+     * top left day cell. Positions outside the table are extrapolated.
+     */
+    QDate date(int position) const;
+
+    /**
+     * Returns the cell position of @p date, which must be in this month.
+     */
+    int position(const QDate &date) const
+    {
+        return date.day() + m_leadingDays;
+    }
+
+    /**
+     * Returns the localized day number shown in cell @p position.
+     */
+    QString dayLabel(int position) const;
+
+    /**
+     * Returns the ISO 8601 week number of the first day in @p row.
+     */
+    int weekNumber(int row) const
+    {
+        return m_weekNumbers[row];
+    }
+
+    /**
+     * Returns the day of the week (1 = Monday) shown in @p column.
+     */
+    int weekDay(int column) const
+    {
+        return m_columns[column].weekDay;
+    }
+
+    /**
+     * Returns the short localized name of the day of the week in @p column.
+     */
+    const QString &shortDayName(int column) const
+    {
+        return m_columns[column].shortDayName;
+    }
+
+    /**
+     * Returns whether the day of the week in @p column is a working day.
+     */
+    bool isWorkingDay(int column) const
+    {
+        return m_columns[column].workingDay;
+    }
+
+private:
+    KCalendarMonth(int year, int month, const QLocale &locale);
+
+    struct Column {
+        int weekDay = 0;
+        bool workingDay = false;
+        QString shortDayName;
+    };
+
+    QLocale m_locale;
+    QDate m_firstOfMonth;
+    // the number of days of the previous month shown in the first row, at least one
+    int m_leadingDays = 0;
+    std::array<QDate, Cells> m_dates;
+    std::array<QString, Cells> m_dayLabels;
+    std::array<int, Rows> m_weekNumbers;
+    std::array<Column, Columns> m_columns;
+};
+
+#endif // KCALENDARMONTH_P_H
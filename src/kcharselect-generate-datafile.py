@@ -23,7 +23,13 @@
 # "kcharselect-translation.cpp" is generated and has to be placed in the same
 # directory.
 #
-# FILE STRUCTURE
+# By default the version 1 format is written, which is the one installed with
+# KCharSelect.  "--format 2" writes the version 2 format, which KCharSelectData
+# reads as well, but which is not shipped yet: until the installed file is
+# regenerated with it, characters outside the BMP cannot be searched by name
+# and the Unihan index is only exercised by the sample of the autotests.
+#
+# FILE STRUCTURE, VERSION 1
 #
 # The generated file is a binary file. The first 40 bytes are the header and
 # contain the position of each part of the file. Each entry is uint32.
@@ -86,8 +92,85 @@
 # 32bit: offset to unihan_strings for Korean
 # 32bit: offset to unihan_strings for JapaneseKun
 # 32bit: offset to unihan_strings for JapaneseOn
+#
+# FILE STRUCTURE, VERSION 2
+#
+# Code points are always uint32, so characters outside the BMP need no
+# remapping.  All strings are kept in one deduplicated string pool and are
+# referred to by their uint32 id.  The first 60 bytes are the header, all
+# entries are uint32 and all parts end where the next one begins.
+#
+# pos   content
+# 0     magic "KCSD"
+# 4     format version, 2
+# 8     string pool buckets begin
+# 12    string pool strings begin
+# 16    names begin
+# 20    details begin
+# 24    lists begin
+# 28    blocks begin
+# 32    section names begin
+# 36    sections begin
+# 40    unihan begin
+# 44    unihan token buckets begin
+# 48    unihan tokens begin
+# 52    unihan postings begin
+# 56    end of the file
+#
+# string pool:
+# the strings are sorted by their UTF-8 bytes and stored in buckets of 16.
+# The first string of a bucket is stored completely, the others as one byte
+# with the length of the prefix shared with the previous string, followed by
+# the rest of the string.  All strings are terminated by a 0x00 byte.
+# A string id is the index of the string in the sorted order, the buckets
+# part has the position of each bucket relative to the strings begin (uint32).
+#
+# names:
+# each entry 8 bytes
+# 32bit: unicode
+# 32bit: string id of the name, the highest byte is the category
+#
+# details:
+# char, alias, alias_count, note, note_count, approxEquiv, approxEquiv_count, equiv, equiv_count, seeAlso, seeAlso_count
+# 32    32     8            32    8           32           8                  32     8            32       8
+# => each entry 29 bytes
+# The 32bit values are positions of lists in the file, count entries of
+# 32bit each: string ids, or code points for seeAlso.
+#
+# blocks:
+# each entry 12 bytes
+# 32bit: start unicode
+# 32bit: end unicode
+# 32bit: string id of the name
+#
+# section names:
+# each entry 4 bytes, the string id of the name
+#
+# sections:
+# each entry 4 bytes, as in version 1
+# 16bit: section index
+# 16bit: block index
+#
+# unihan:
+# each entry 32 bytes
+# 32bit: unicode
+# 7 x 32bit: string ids of Definition, Cantonese, Mandarin, Tang, Korean,
+#            JapaneseKun and JapaneseOn, 0xFFFFFFFF if there is none
+#
+# unihan token index:
+# the unihan values split into lowercase words the same way
+# KCharSelectData::splitString() does.  The tokens are sorted by their UTF-8
+# bytes and front-coded like the string pool, but every token is followed by
+# the position of its posting list relative to the postings begin (uint32),
+# and the shared prefix byte is present for every token (0 at the start of a
+# bucket).  The token buckets part has the position of each bucket of 16
+# tokens relative to the tokens begin (uint32).
+# A posting list is the number of characters followed by their code points
+# in ascending order, the first one as it is and the others as the
+# difference to the previous one.  All numbers are LEB128 varints.
 
 from struct import *
+import argparse
 import sys
 import re
 import io
@@ -337,14 +420,18 @@ categoryMap = { # same values as QChar::Category
 }
 
 
-# Temporary code point remapping
+# Temporary code point remapping, only for the version 1 format
 #
 # Initial SMP support without needing a new data file format
 # - BMP U+Fxxx are remapped to U+Exxx
 # - SMP symbols U+1Fxxx are remapped to U+Fxxx
 # - Private Use Area is limited to U+F000 ... U+F8FF
 
+formatVersion = 1
+
 def remap(char):
+    if formatVersion != 1:
+        return char
     cp = int(char, 16)
     if cp >= 0xE000 and cp <= 0xFFFF:
         return "E"+char[1:]
@@ -637,7 +724,7 @@ class Parser:
             uni = remap(m.group(1))
             name = m.group(2)
             category = m.group(3)
-            if len(uni) > 4:
+            if formatVersion == 1 and len(uni) > 4:
                 continue
             names.addName(uni, name, categoryMap[category])
 
@@ -669,7 +756,7 @@ class Parser:
             elif m1:
                 mg1 = remap(m1.group(1))
                 currChar = int(mg1, 16)
-                if len(mg1) > 4:
+                if formatVersion == 1 and len(mg1) > 4:
                     drop = 1
                     continue
             elif drop == 1:
@@ -688,11 +775,11 @@ class Parser:
                 details.addEntry(currChar, "equiv", value)
             elif m6:
                 value = int(remap(m6.group(1)), 16)
-                if value < 0x10000:
+                if formatVersion != 1 or value < 0x10000:
                     details.addEntry(currChar, "seeAlso", value)
             elif m7:
                 value = int(remap(m7.group(1)), 16)
-                if value < 0x10000:
+                if formatVersion != 1 or value < 0x10000:
                     details.addEntry(currChar, "seeAlso", value)
     def parseBlocks(self, inBlocks, sectionsBlocks):
         regexp = re.compile(r'^([0-9A-F]+)\.\.([0-9A-F]+); (.+)$')
@@ -703,7 +790,7 @@ class Parser:
                 continue
             m1 = remap(m.group(1))
             m2 = remap(m.group(2))
-            if len(m1) > 4:
+            if formatVersion == 1 and len(m1) > 4:
                 continue
             sectionsBlocks.addBlock(m1, m2, m.group(3))
     def parseSections(self, inSections, sectionsBlocks):
@@ -731,9 +818,204 @@ class Parser:
             m = regexp.match(line)
             if not m:
                 continue
-            if len(remap(m.group(1))) <= 4:
+            if formatVersion != 1 or len(remap(m.group(1))) <= 4:
                 unihan.addUnihan(remap(m.group(1)), m.group(2), m.group(3))
 
+class StringPool:
+    """Deduplicated, front-coded strings of the version 2 format"""
+    BUCKET_SIZE = 16
+
+    def __init__(self):
+        self.strings = set()
+        self.ids = {}
+
+    def add(self, string):
+        self.strings.add(string)
+
+    def finish(self):
+        self.sorted = sorted(self.strings, key=lambda string: string.encode("utf-8"))
+        self.ids = {string: index for index, string in enumerate(self.sorted)}
+
+    def id(self, string):
+        return self.ids[string]
+
+    def serialize(self):
+        buckets = bytearray()
+        strings = bytearray()
+        previous = b""
+        for index, string in enumerate(self.sorted):
+            encoded = string.encode("utf-8")
+            if index % self.BUCKET_SIZE == 0:
+                buckets += pack("=I", len(strings))
+                strings += encoded + b"\0"
+            else:
+                prefix = 0
+                limit = min(len(previous), len(encoded), 255)
+                while prefix < limit and previous[prefix] == encoded[prefix]:
+                    prefix += 1
+                strings += pack("=B", prefix) + encoded[prefix:] + b"\0"
+            previous = encoded
+        return bytes(buckets), bytes(strings)
+
+def packVarint(value):
+    """Unsigned LEB128, 7 bits per byte, the highest bit set if more bytes follow"""
+    data = bytearray()
+    while value >= 0x80:
+        data.append((value & 0x7F) | 0x80)
+        value >>= 7
+    data.append(value)
+    return bytes(data)
+
+def splitString(string):
+    """Same splitting as KCharSelectData::splitString()"""
+    return re.findall(r"(?:[^\W_]|\+)+", string)
+
+def serializeUnihanIndex(unihan):
+    postings = {}
+    for char, values in unihan.unihan.items():
+        for value in values:
+            if value != None:
+                for token in splitString(value):
+                    postings.setdefault(token.lower(), set()).add(char)
+
+    buckets = bytearray()
+    tokens = bytearray()
+    postingsPart = bytearray()
+    previous = b""
+    for index, token in enumerate(sorted(postings.keys(), key=lambda token: token.encode("utf-8"))):
+        encoded = token.encode("utf-8")
+        prefix = 0
+        if index % StringPool.BUCKET_SIZE == 0:
+            buckets += pack("=I", len(tokens))
+        else:
+            limit = min(len(previous), len(encoded), 255)
+            while prefix < limit and previous[prefix] == encoded[prefix]:
+                prefix += 1
+        tokens += pack("=B", prefix) + encoded[prefix:] + b"\0" + pack("=I", len(postingsPart))
+        previous = encoded
+
+        chars = sorted(postings[token])
+        postingsPart += packVarint(len(chars))
+        last = 0
+        for char in chars:
+            postingsPart += packVarint(char - last)
+            last = char
+    print(len(postings), "unihan tokens,", len(buckets) + len(tokens) + len(postingsPart), "bytes of index")
+    return bytes(buckets), bytes(tokens), bytes(postingsPart)
+
+def writeVersion2(out, names, details, sectionsBlocks, unihan):
+    detailCategories = ["alias", "note", "approxEquiv", "equiv", "seeAlso"]
+
+    # blocks which are not listed in sectiondata end up in "Other",
+    # there are too many supplementary blocks to keep the list complete
+    blockNames = [block[2] for block in sectionsBlocks.blocks]
+    sectionedBlocks = [section[1] for section in sectionsBlocks.sections]
+    for name in blockNames:
+        if not name in sectionedBlocks:
+            print("Block \"" + name + "\" is not listed in any section, adding it to \"Other\"")
+            sectionsBlocks.addSection("Other", name)
+    sections = []
+    for section in sectionsBlocks.sections:
+        if section[1] in blockNames:
+            sections.append([sectionsBlocks.sectionList.index(section[0]), blockNames.index(section[1])])
+        else:
+            print("Block \"" + section[1] + "\" of section \"" + section[0] + "\" does not exist, skipping it")
+
+    pool = StringPool()
+    for entry in names.names:
+        pool.add(entry[1])
+    for char in details.details.values():
+        for category, values in char.items():
+            if category != "seeAlso":
+                for value in values:
+                    pool.add(value)
+    for name in blockNames:
+        pool.add(name)
+    for name in sectionsBlocks.sectionList:
+        pool.add(name)
+    for values in unihan.unihan.values():
+        for value in values:
+            if value != None:
+                pool.add(value)
+    pool.finish()
+
+    poolBuckets, poolStrings = pool.serialize()
+
+    namesPart = bytearray()
+    for entry in sorted(names.names, key=lambda entry: int(entry[0], 16)):
+        namesPart += pack("=II", int(entry[0], 16), pool.id(entry[1]) | (entry[2] << 24))
+
+    # string ids, or code points for seeAlso, five lists per character
+    detailLists = []
+    for char in sorted(details.details.keys()):
+        for category in detailCategories:
+            values = details.details[char].get(category, [])
+            if category != "seeAlso":
+                values = [pool.id(value) for value in values]
+            detailLists.append(values)
+
+    blocksPart = bytearray()
+    for block in sectionsBlocks.blocks:
+        blocksPart += pack("=III", int(block[0], 16), int(block[1], 16), pool.id(block[2]))
+
+    sectionNamesPart = bytearray()
+    for name in sectionsBlocks.sectionList:
+        sectionNamesPart += pack("=I", pool.id(name))
+
+    sectionsPart = bytearray()
+    for section in sections:
+        sectionsPart += pack("=HH", section[0], section[1])
+
+    unihanPart = bytearray()
+    for char in sorted(unihan.unihan.keys()):
+        unihanPart += pack("=I", char)
+        for value in unihan.unihan[char]:
+            unihanPart += pack("=I", pool.id(value) if value != None else 0xFFFFFFFF)
+
+    unihanTokenBuckets, unihanTokens, unihanPostings = serializeUnihanIndex(unihan)
+
+    headerSize = 60
+    poolBucketsBegin = headerSize
+    poolStringsBegin = poolBucketsBegin + len(poolBuckets)
+    namesBegin = poolStringsBegin + len(poolStrings)
+    detailsBegin = namesBegin + len(namesPart)
+    listsBegin = detailsBegin + len(details.details) * 29
+
+    listsPart = bytearray()
+    listPositions = []
+    for values in detailLists:
+        listPositions.append(listsBegin + len(listsPart))
+        for value in values:
+            listsPart += pack("=I", value)
+    detailsPart = bytearray()
+    index = 0
+    for char in sorted(details.details.keys()):
+        detailsPart += pack("=I", char)
+        for category in detailCategories:
+            values = detailLists[index]
+            detailsPart += pack("=IB", listPositions[index] if values else 0, len(values))
+            index += 1
+
+    blocksBegin = listsBegin + len(listsPart)
+    sectionNamesBegin = blocksBegin + len(blocksPart)
+    sectionsBegin = sectionNamesBegin + len(sectionNamesPart)
+    unihanBegin = sectionsBegin + len(sectionsPart)
+    unihanTokenBucketsBegin = unihanBegin + len(unihanPart)
+    unihanTokensBegin = unihanTokenBucketsBegin + len(unihanTokenBuckets)
+    unihanPostingsBegin = unihanTokensBegin + len(unihanTokens)
+    end = unihanPostingsBegin + len(unihanPostings)
+
+    print("========== writing version 2 ===============")
+    out.write(b"KCSD")
+    out.write(pack("=14I", 2, poolBucketsBegin, poolStringsBegin, namesBegin, detailsBegin, listsBegin,
+                   blocksBegin, sectionNamesBegin, sectionsBegin, unihanBegin,
+                   unihanTokenBucketsBegin, unihanTokensBegin, unihanPostingsBegin, end))
+    for part in [poolBuckets, poolStrings, namesPart, detailsPart, listsPart, blocksPart, sectionNamesPart, sectionsPart, unihanPart,
+                 unihanTokenBuckets, unihanTokens, unihanPostings]:
+        out.write(part)
+    print(len(pool.sorted), "strings in the pool,", len(poolStrings), "bytes")
+    print("done, size", end)
+
 def writeTranslationDummy(out, data):
     out.write(b"""/* This file is part of the KDE libraries
 
@@ -748,6 +1030,10 @@ def writeTranslationDummy(out, data):
         for entry in group[1]:
             out.write(b"QT_TRANSLATE_NOOP3(\"KCharSelectData\", \""+entry.encode("utf-8")+b"\", \""+group[0].encode("utf-8")+b"\");\n")
 
+argumentParser = argparse.ArgumentParser(description="Generates the data file of KCharSelect.")
+argumentParser.add_argument("--format", type=int, choices=[1, 2], default=1, help="version of the data file format")
+formatVersion = argumentParser.parse_args().format
+
 out = open("kcharselect-data", "wb")
 outTranslationDummy = open("kcharselect-translation.cpp", "wb")
 
@@ -782,76 +1068,79 @@ print("\b."); sys.stdout.flush()
 
 print("done.")
 
-pos = 0
-
-#write header, size: 40 bytes
-print("========== writing header ==================")
-out.write(pack("=I", 40))
-print("names strings begin", 40)
-
-namesOffsetBegin = names.calculateStringSize() + 40
-out.write(pack("=I", namesOffsetBegin))
-print("names offsets begin", namesOffsetBegin)
-
-detailsStringBegin = namesOffsetBegin + names.calculateOffsetSize()
-out.write(pack("=I", detailsStringBegin))
-print("details strings begin", detailsStringBegin)
-
-detailsOffsetBegin = detailsStringBegin + details.calculateStringSize()
-out.write(pack("=I", detailsOffsetBegin))
-print("details offsets begin", detailsOffsetBegin)
-
-blocksStringBegin = detailsOffsetBegin + details.calculateOffsetSize()
-out.write(pack("=I", blocksStringBegin))
-print("block strings begin", blocksStringBegin)
-
-blocksOffsetBegin = blocksStringBegin + sectionsBlocks.calculateBlockStringSize()
-out.write(pack("=I", blocksOffsetBegin))
-print("block offsets begin", blocksOffsetBegin)
-
-sectionStringBegin = blocksOffsetBegin + sectionsBlocks.calculateBlockOffsetSize()
-out.write(pack("=I", sectionStringBegin))
-print("section strings begin", sectionStringBegin)
-
-sectionOffsetBegin = sectionStringBegin + sectionsBlocks.calculateSectionStringSize()
-out.write(pack("=I", sectionOffsetBegin))
-print("section offsets begin", sectionOffsetBegin)
-
-unihanStringBegin = sectionOffsetBegin + sectionsBlocks.calculateSectionOffsetSize()
-out.write(pack("=I", unihanStringBegin))
-print("unihan strings begin", unihanStringBegin)
-
-unihanOffsetBegin = unihanStringBegin + unihan.calculateStringSize()
-out.write(pack("=I", unihanOffsetBegin))
-print("unihan offsets begin", unihanOffsetBegin)
-
-end = unihanOffsetBegin + unihan.calculateOffsetSize()
-print("end should be", end)
-
-pos += 40
-
-print("========== writing data ====================")
-
-pos = names.writeStrings(out, pos)
-print("names strings written, position", pos)
-pos = names.writeOffsets(out, pos)
-print("names offsets written, position", pos)
-pos = details.writeStrings(out, pos)
-print("details strings written, position", pos)
-pos = details.writeOffsets(out, pos)
-print("details offsets written, position", pos)
-pos = sectionsBlocks.writeBlockStrings(out, pos)
-print("block strings written, position", pos)
-pos = sectionsBlocks.writeBlockOffsets(out, pos)
-print("block offsets written, position", pos)
-pos = sectionsBlocks.writeSectionStrings(out, pos)
-print("section strings written, position", pos)
-pos = sectionsBlocks.writeSectionOffsets(out, pos)
-print("section offsets written, position", pos)
-pos = unihan.writeStrings(out, pos)
-print("unihan strings written, position", pos)
-pos = unihan.writeOffsets(out, pos)
-print("unihan offsets written, position", pos)
+if formatVersion == 2:
+    writeVersion2(out, names, details, sectionsBlocks, unihan)
+else:
+    pos = 0
+
+    #write header, size: 40 bytes
+    print("========== writing header ==================")
+    out.write(pack("=I", 40))
+    print("names strings begin", 40)
+
+    namesOffsetBegin = names.calculateStringSize() + 40
+    out.write(pack("=I", namesOffsetBegin))
+    print("names offsets begin", namesOffsetBegin)
+
+    detailsStringBegin = namesOffsetBegin + names.calculateOffsetSize()
+    out.write(pack("=I", detailsStringBegin))
+    print("details strings begin", detailsStringBegin)
+
+    detailsOffsetBegin = detailsStringBegin + details.calculateStringSize()
+    out.write(pack("=I", detailsOffsetBegin))
+    print("details offsets begin", detailsOffsetBegin)
+
+    blocksStringBegin = detailsOffsetBegin + details.calculateOffsetSize()
+    out.write(pack("=I", blocksStringBegin))
+    print("block strings begin", blocksStringBegin)
+
+    blocksOffsetBegin = blocksStringBegin + sectionsBlocks.calculateBlockStringSize()
+    out.write(pack("=I", blocksOffsetBegin))
+    print("block offsets begin", blocksOffsetBegin)
+
+    sectionStringBegin = blocksOffsetBegin + sectionsBlocks.calculateBlockOffsetSize()
+    out.write(pack("=I", sectionStringBegin))
+    print("section strings begin", sectionStringBegin)
+
+    sectionOffsetBegin = sectionStringBegin + sectionsBlocks.calculateSectionStringSize()
+    out.write(pack("=I", sectionOffsetBegin))
+    print("section offsets begin", sectionOffsetBegin)
+
+    unihanStringBegin = sectionOffsetBegin + sectionsBlocks.calculateSectionOffsetSize()
+    out.write(pack("=I", unihanStringBegin))
+    print("unihan strings begin", unihanStringBegin)
+
+    unihanOffsetBegin = unihanStringBegin + unihan.calculateStringSize()
+    out.write(pack("=I", unihanOffsetBegin))
+    print("unihan offsets begin", unihanOffsetBegin)
+
+    end = unihanOffsetBegin + unihan.calculateOffsetSize()
+    print("end should be", end)
+
+    pos += 40
+
+    print("========== writing data ====================")
+
+    pos = names.writeStrings(out, pos)
+    print("names strings written, position", pos)
+    pos = names.writeOffsets(out, pos)
+    print("names offsets written, position", pos)
+    pos = details.writeStrings(out, pos)
+    print("details strings written, position", pos)
+    pos = details.writeOffsets(out, pos)
+    print("details offsets written, position", pos)
+    pos = sectionsBlocks.writeBlockStrings(out, pos)
+    print("block strings written, position", pos)
+    pos = sectionsBlocks.writeBlockOffsets(out, pos)
+    print("block offsets written, position", pos)
+    pos = sectionsBlocks.writeSectionStrings(out, pos)
+    print("section strings written, position", pos)
+    pos = sectionsBlocks.writeSectionOffsets(out, pos)
+    print("section offsets written, position", pos)
+    pos = unihan.writeStrings(out, pos)
+    print("unihan strings written, position", pos)
+    pos = unihan.writeOffsets(out, pos)
+    print("unihan offsets written, position", pos)
 
 print("========== writing translation dummy  ======")
 translationData = [["KCharSelect section name", sectionsBlocks.getSectionList()], ["KCharselect unicode block name",sectionsBlocks.getBlockList()]]
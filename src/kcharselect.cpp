@@ -15,6 +15,7 @@
 #include <QActionEvent>
 #include <QApplication>
 #include <QBoxLayout>
+#include <QCache>
 #include <QComboBox>
 #include <QDebug>
 #include <QDoubleSpinBox>
@@ -29,6 +30,30 @@
 
 Q_GLOBAL_STATIC(KCharSelectData, s_data)
 
+// delay in ms before the details of a quickly changing current character are shown
+static constexpr int DetailUpdateDelay = 100;
+static constexpr int MaxCachedDetails = 64;
+// typical size of the detail HTML, enough for most characters
+static constexpr int DetailHtmlReserve = 4096;
+
+// the detail HTML depends on the font used to check whether a character is displayable,
+// and on the translations, which is why the cache is cleared when the language changes
+struct KCharSelectDetailKey {
+    uint c;
+    bool allPlanesEnabled;
+    QString font;
+
+    bool operator==(const KCharSelectDetailKey &other) const
+    {
+        return c == other.c && allPlanesEnabled == other.allPlanesEnabled && font == other.font;
+    }
+};
+
+static size_t qHash(const KCharSelectDetailKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.c, key.allPlanesEnabled, key.font);
+}
+
 class KCharSelectTablePrivate
 {
 public:
@@ -41,10 +66,15 @@ public:
 
     QFont font;
     KCharSelectItemModel *model = nullptr;
-    QList<uint> chars;
+    KCharSelectContents chars;
     uint chr = 0;
+    // widest printable character of each block range in the current font, keyed by
+    // the first code point of the range, measuring all of them again every time the
+    // "All" section is shown would take much longer than switching to it
+    QHash<uint, int> blockWidths;
 
     void resizeCells();
+    int displayedCharsWidth(const QFontMetrics &fontMetrics);
     void doubleClicked(const QModelIndex &index);
     void slotSelectionChanged(const QItemSelection &selected, const QItemSelection &deselected);
 };
@@ -78,6 +108,10 @@ public:
     QComboBox *blockCombo = nullptr;
     KCharSelectTable *charTable = nullptr;
     QTextBrowser *detailBrowser = nullptr;
+    QTimer *detailTimer = nullptr;
+    QCache<KCharSelectDetailKey, QString> detailCache{MaxCachedDetails};
+    uint pendingDetailChar = 0;
+    bool detailUpdatePending = false;
 
     bool searchMode = false; // a search is active
     bool historyEnabled = false;
@@ -96,7 +130,9 @@ public:
     void fontSelected();
     void charSelected(uint c);
     void updateCurrentChar(uint c);
+    void scheduleDetailUpdate(uint c);
     void slotUpdateUnicode(uint c);
+    QString createDetailHtml(uint c);
     void sectionSelected(int index);
     void blockSelected(int index);
     void searchEditChanged();
@@ -146,6 +182,7 @@ void KCharSelectTable::setFont(const QFont &_font)
 {
     QTableView::setFont(_font);
     d->font = _font;
+    d->blockWidths.clear();
     if (d->model) {
         d->model->setFont(_font);
     }
@@ -164,7 +201,7 @@ QFont KCharSelectTable::font() const
 
 QList<uint> KCharSelectTable::displayedChars() const
 {
-    return d->chars;
+    return d->chars.toList();
 }
 
 void KCharSelectTable::setChar(uint c)
@@ -176,6 +213,11 @@ void KCharSelectTable::setChar(uint c)
 }
 
 void KCharSelectTable::setContents(const QList<uint> &chars)
+{
+    setContents(KCharSelectContents(chars));
+}
+
+void KCharSelectTable::setContents(const KCharSelectContents &chars)
 {
     d->chars = chars;
 
@@ -241,6 +283,57 @@ void KCharSelectTable::resizeEvent(QResizeEvent *e)
     }
 }
 
+static int measureChars(const QFontMetrics &fontMetrics, uint first, uint last)
+{
+    int maxCharWidth = 0;
+    for (char32_t thisChar = first; thisChar <= last; ++thisChar) {
+        if (s_data()->isPrint(thisChar)) {
+            maxCharWidth = qMax(maxCharWidth, fontMetrics.boundingRect(QString::fromUcs4(&thisChar, 1)).width());
+        }
+    }
+    return maxCharWidth;
+}
+
+// Determine the max width of the displayed characters
+// fontMetrics.maxWidth() doesn't help because of font fallbacks
+// (testcase: Malayalam characters)
+int KCharSelectTablePrivate::displayedCharsWidth(const QFontMetrics &fontMetrics)
+{
+    int maxCharWidth = 0;
+    for (const KCharSelectData::Range &range : chars.ranges()) {
+        uint first = range.first;
+        while (first <= range.last) {
+            // split the range where the block ranges end, whole block ranges are cached
+            uint last = first;
+            bool wholeBlock = false;
+            const QList<KCharSelectData::Range> blockRanges = s_data()->blockRanges(s_data()->blockIndex(first));
+            for (const KCharSelectData::Range &blockRange : blockRanges) {
+                if (first >= blockRange.first && first <= blockRange.last) {
+                    last = qMin(range.last, blockRange.last);
+                    wholeBlock = first == blockRange.first && last == blockRange.last;
+                    break;
+                }
+            }
+
+            if (!wholeBlock) {
+                maxCharWidth = qMax(maxCharWidth, measureChars(fontMetrics, first, last));
+            } else {
+                auto it = blockWidths.constFind(first);
+                if (it == blockWidths.cend()) {
+                    it = blockWidths.insert(first, measureChars(fontMetrics, first, last));
+                }
+                maxCharWidth = qMax(maxCharWidth, *it);
+            }
+
+            if (last == range.last) {
+                break;
+            }
+            first = last + 1;
+        }
+    }
+    return maxCharWidth;
+}
+
 void KCharSelectTablePrivate::resizeCells()
 {
     KCharSelectItemModel *model = static_cast<KCharSelectItemModel *>(q->model());
@@ -252,17 +345,7 @@ void KCharSelectTablePrivate::resizeCells()
 
     QFontMetrics fontMetrics(font);
 
-    // Determine the max width of the displayed characters
-    // fontMetrics.maxWidth() doesn't help because of font fallbacks
-    // (testcase: Malayalam characters)
-    int maxCharWidth = 0;
-    const QList<uint> chars = model->chars();
-    for (int i = 0; i < chars.size(); ++i) {
-        char32_t thisChar = chars.at(i);
-        if (s_data()->isPrint(thisChar)) {
-            maxCharWidth = qMax(maxCharWidth, fontMetrics.boundingRect(QString::fromUcs4(&thisChar, 1)).width());
-        }
-    }
+    int maxCharWidth = displayedCharsWidth(fontMetrics);
     // Avoid too narrow cells
     maxCharWidth = qMax(maxCharWidth, 2 * fontMetrics.xHeight());
     maxCharWidth = qMax(maxCharWidth, fontMetrics.height());
@@ -557,6 +640,16 @@ void KCharSelect::initWidget(const Controls controls, QObject *actionParent)
         d->linkClicked(url);
     });
 
+    d->detailTimer = new QTimer(this);
+    d->detailTimer->setSingleShot(true);
+    d->detailTimer->setInterval(DetailUpdateDelay);
+    connect(d->detailTimer, &QTimer::timeout, this, [this]() {
+        if (d->detailUpdatePending) {
+            d->detailUpdatePending = false;
+            d->slotUpdateUnicode(d->pendingDetailChar);
+        }
+    });
+
     setFocusPolicy(Qt::StrongFocus);
     if (SearchLine & controls) {
         setFocusProxy(d->searchLine);
@@ -577,6 +670,15 @@ QSize KCharSelect::sizeHint() const
     return QWidget::sizeHint();
 }
 
+void KCharSelect::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::LanguageChange) {
+        d->detailCache.clear();
+        d->slotUpdateUnicode(currentCodePoint());
+    }
+    QWidget::changeEvent(event);
+}
+
 void KCharSelect::setCurrentFont(const QFont &_font)
 {
     d->fontCombo->setCurrentFont(_font);
@@ -787,13 +889,39 @@ void KCharSelectPrivate::updateCurrentChar(uint c)
         historyAdd(c, searchMode, searchLine->text());
     }
 
-    slotUpdateUnicode(c);
+    scheduleDetailUpdate(c);
+}
+
+void KCharSelectPrivate::scheduleDetailUpdate(uint c)
+{
+    // the first change is shown right away, further changes in quick succession
+    // (e.g. while an arrow key is held down) only once they stop
+    if (detailTimer->isActive()) {
+        pendingDetailChar = c;
+        detailUpdatePending = true;
+    } else {
+        slotUpdateUnicode(c);
+    }
+    detailTimer->start();
 }
 
 void KCharSelectPrivate::slotUpdateUnicode(uint c)
 {
-    QString html = QLatin1String("<p>") + tr("Character:") + QLatin1Char(' ') + s_data()->display(c, charTable->font()) + QLatin1Char(' ')
-        + s_data()->formatCode(c) + QLatin1String("<br />");
+    const KCharSelectDetailKey key{c, allPlanesEnabled, charTable->font().key()};
+    QString *html = detailCache.object(key);
+    if (!html) {
+        html = new QString(createDetailHtml(c));
+        detailCache.insert(key, html);
+    }
+    detailBrowser->setHtml(*html);
+}
+
+QString KCharSelectPrivate::createDetailHtml(uint c)
+{
+    QString html;
+    html.reserve(DetailHtmlReserve);
+    html += QLatin1String("<p>") + tr("Character:") + QLatin1Char(' ') + s_data()->display(c, charTable->font()) + QLatin1Char(' ') + s_data()->formatCode(c)
+        + QLatin1String("<br />");
 
     QString name = s_data()->name(c);
     if (!name.isEmpty()) {
@@ -945,7 +1073,7 @@ void KCharSelectPrivate::slotUpdateUnicode(uint c)
     }
     html += QLatin1String("<br>") + tr("XML decimal entity:") + QLatin1String(" &amp;#") + QString::number(c) + QLatin1String(";</p>");
 
-    detailBrowser->setHtml(html);
+    return html;
 }
 
 QString KCharSelectPrivate::createLinks(QString s)
@@ -978,18 +1106,20 @@ QString KCharSelectPrivate::createLinks(QString s)
 void KCharSelectPrivate::sectionSelected(int index)
 {
     blockCombo->clear();
-    QList<uint> chars;
+    KCharSelectContents chars;
     const QList<int> blocks = s_data()->sectionContents(index);
     for (int block : blocks) {
+        const QList<KCharSelectData::Range> ranges = s_data()->blockRanges(block);
         if (!allPlanesEnabled) {
-            const QList<uint> contents = s_data()->blockContents(block);
-            if (!contents.isEmpty() && QChar::requiresSurrogates(contents.at(0))) {
+            if (!ranges.isEmpty() && QChar::requiresSurrogates(ranges.at(0).first)) {
                 continue;
             }
         }
         blockCombo->addItem(s_data()->blockName(block), QVariant(block));
         if (index == 0) {
-            chars << s_data()->blockContents(block);
+            for (const KCharSelectData::Range &range : ranges) {
+                chars.append(range);
+            }
         }
     }
     if (index == 0) {
@@ -1015,12 +1145,16 @@ void KCharSelectPrivate::blockSelected(int index)
         // the selected block already contains the selected character
         return;
     }
-    const QList<uint> contents = s_data()->blockContents(block);
+    KCharSelectContents contents;
+    const QList<KCharSelectData::Range> ranges = s_data()->blockRanges(block);
+    for (const KCharSelectData::Range &range : ranges) {
+        contents.append(range);
+    }
     if (sectionCombo->currentIndex() > 0) {
         charTable->setContents(contents);
     }
     Q_EMIT q->displayedCharsChanged();
-    charTable->setChar(contents[0]);
+    charTable->setChar(contents.at(0));
 }
 
 void KCharSelectPrivate::searchEditChanged()
@@ -1082,6 +1216,56 @@ void KCharSelectPrivate::linkClicked(QUrl url)
 
 ////
 
+KCharSelectContents::KCharSelectContents(const QList<uint> &chars)
+{
+    for (uint c : chars) {
+        append({c, c});
+    }
+}
+
+void KCharSelectContents::append(const KCharSelectData::Range &range)
+{
+    if (!m_ranges.isEmpty() && m_ranges.last().last + 1 == range.first) {
+        m_ranges.last().last = range.last;
+    } else {
+        m_ranges.append(range);
+        m_offsets.append(m_size);
+    }
+    m_size += range.last - range.first + 1;
+}
+
+uint KCharSelectContents::at(int pos) const
+{
+    Q_ASSERT(pos >= 0 && pos < m_size);
+    // the last range starting at or before pos
+    const auto it = std::upper_bound(m_offsets.cbegin(), m_offsets.cend(), pos) - 1;
+    const int range = it - m_offsets.cbegin();
+    return m_ranges.at(range).first + (pos - *it);
+}
+
+int KCharSelectContents::indexOf(uint c) const
+{
+    for (int i = 0; i < m_ranges.size(); ++i) {
+        const KCharSelectData::Range &range = m_ranges.at(i);
+        if (c >= range.first && c <= range.last) {
+            return m_offsets.at(i) + (c - range.first);
+        }
+    }
+    return -1;
+}
+
+QList<uint> KCharSelectContents::toList() const
+{
+    QList<uint> result;
+    result.reserve(m_size);
+    for (const KCharSelectData::Range &range : m_ranges) {
+        for (uint c = range.first; c <= range.last; ++c) {
+            result.append(c);
+        }
+    }
+    return result;
+}
+
 QVariant KCharSelectItemModel::data(const QModelIndex &index, int role) const
 {
     int pos = m_columns * (index.row()) + index.column();
@@ -1092,7 +1276,7 @@ QVariant KCharSelectItemModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
-    char32_t c = m_chars[pos];
+    char32_t c = m_chars.at(pos);
     if (role == Qt::ToolTipRole) {
         QString result = s_data()->display(c, m_font) + QLatin1String("<br />") + s_data()->name(c).toHtmlEscaped() + QLatin1String("<br />")
             + tr("Unicode code point:") + QLatin1Char(' ') + s_data()->formatCode(c) + QLatin1String("<br />") + tr("In decimal", "Character")
@@ -271,6 +271,12 @@ Q_SIGNALS:
      */
     void codePointSelected(uint codePoint);
 
+protected:
+    /**
+     * Reimplemented.
+     */
+    void changeEvent(QEvent *event) override;
+
 private:
     KWIDGETSADDONS_NO_EXPORT void initWidget(const Controls, QObject *);
 
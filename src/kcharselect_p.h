@@ -18,6 +18,45 @@
 
 class KCharSelectTablePrivate;
 
+/**
+ * The characters shown by KCharSelectTable, stored as ranges of
+ * consecutive code points. Positions are mapped to code points
+ * arithmetically, so whole sections of blocks cost only one entry
+ * per block.
+ */
+class KCharSelectContents
+{
+public:
+    KCharSelectContents() = default;
+    explicit KCharSelectContents(const QList<uint> &chars);
+
+    /** Appends the code points of @p range, merging it with the last range if they are adjacent. */
+    void append(const KCharSelectData::Range &range);
+
+    int size() const
+    {
+        return m_size;
+    }
+    bool isEmpty() const
+    {
+        return m_size == 0;
+    }
+
+    uint at(int pos) const;
+    /** @return the position of @p c, or -1 if it is not contained */
+    int indexOf(uint c) const;
+    QList<uint> toList() const;
+    const QList<KCharSelectData::Range> &ranges() const
+    {
+        return m_ranges;
+    }
+
+private:
+    QList<KCharSelectData::Range> m_ranges;
+    QList<int> m_offsets; // position of the first code point of each range
+    int m_size = 0;
+};
+
 /**
  * @short Character selection table
  *
@@ -51,6 +90,7 @@ public:
     void setChar(uint c);
     /** Set the contents of the table to @p chars . */
     void setContents(const QList<uint> &chars);
+    void setContents(const KCharSelectContents &chars);
 
     /** @return Currently highlighted character. */
     uint chr();
@@ -95,13 +135,13 @@ class KCharSelectItemModel : public QAbstractTableModel
 {
     Q_OBJECT
 public:
-    KCharSelectItemModel(const QList<uint> &chars, const QFont &font, QObject *parent)
+    KCharSelectItemModel(const KCharSelectContents &chars, const QFont &font, QObject *parent)
         : QAbstractTableModel(parent)
         , m_chars(chars)
         , m_font(font)
     {
         if (!chars.isEmpty()) {
-            m_columns = chars.count();
+            m_columns = chars.size();
         } else {
             m_columns = 1;
         }
@@ -113,10 +153,10 @@ public:
         if (parent.isValid()) {
             return 0;
         }
-        if (m_chars.count() % m_columns == 0) {
-            return m_chars.count() / m_columns;
+        if (m_chars.size() % m_columns == 0) {
+            return m_chars.size() / m_columns;
         } else {
-            return m_chars.count() / m_columns + 1;
+            return m_chars.size() / m_columns + 1;
         }
     }
     int columnCount(const QModelIndex & = QModelIndex()) const override
@@ -161,13 +201,13 @@ public:
 
     void setColumnCount(int columns);
 
-    QList<uint> chars() const
+    const KCharSelectContents &chars() const
     {
         return m_chars;
     }
 
 private:
-    QList<uint> m_chars;
+    KCharSelectContents m_chars;
     QFont m_font;
     int m_columns;
 
@@ -6,6 +6,7 @@
 */
 
 #include "kcharselectdata_p.h"
+#include "ktracing_p.h"
 
 #include <QCoreApplication>
 #include <QFile>
@@ -80,6 +81,231 @@ static const char JAMO_T_TABLE[][4] = {
 };
 // clang-format on
 
+// Layout of the version 2 data file, see kcharselect-generate-datafile.py
+namespace V2
+{
+enum HeaderPosition {
+    Version = 4,
+    PoolBuckets = 8,
+    PoolStrings = 12,
+    Names = 16,
+    Details = 20,
+    Lists = 24,
+    Blocks = 28,
+    SectionNames = 32,
+    Sections = 36,
+    Unihan = 40,
+    UnihanTokenBuckets = 44,
+    UnihanTokens = 48,
+    UnihanPostings = 52,
+    End = 56,
+    HeaderSize = 60,
+};
+
+enum DetailField {
+    Aliases,
+    Notes,
+    ApproximateEquivalents,
+    Equivalents,
+    SeeAlso,
+};
+
+const char Magic[] = "KCSD";
+constexpr int PoolBucketSize = 16;
+constexpr int NameEntrySize = 8;
+constexpr int DetailEntrySize = 29;
+constexpr int BlockEntrySize = 12;
+constexpr int UnihanEntrySize = 32;
+constexpr int UnihanFields = 7;
+constexpr quint32 NoString = 0xFFFFFFFF;
+
+static quint32 headerValue(const QByteArray &dataFile, int position)
+{
+    return qFromLittleEndian<quint32>(dataFile.constData() + position);
+}
+
+// every part has to be inside the file, and the parts made of entries have to hold whole entries
+static bool isValid(const QByteArray &dataFile)
+{
+    if (dataFile.size() < HeaderSize || headerValue(dataFile, Version) != 2) {
+        return false;
+    }
+
+    // every part ends where the next one begins, the last one with End
+    quint32 previous = HeaderSize;
+    for (int position = PoolBuckets; position <= End; position += 4) {
+        const quint32 offset = headerValue(dataFile, position);
+        if (offset < previous || offset > quint32(dataFile.size())) {
+            return false;
+        }
+        previous = offset;
+    }
+
+    const struct {
+        HeaderPosition part;
+        int entrySize;
+    } entryParts[] = {
+        {PoolBuckets, 4},
+        {Names, NameEntrySize},
+        {Details, DetailEntrySize},
+        {Lists, 4},
+        {Blocks, BlockEntrySize},
+        {SectionNames, 4},
+        {Sections, 4},
+        {Unihan, UnihanEntrySize},
+        {UnihanTokenBuckets, 4},
+    };
+    for (const auto &entryPart : entryParts) {
+        if ((headerValue(dataFile, entryPart.part + 4) - headerValue(dataFile, entryPart.part)) % entryPart.entrySize != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the entries of each part are sorted by the code point they start with
+static quint32 findEntry(const QByteArray &dataFile, HeaderPosition part, int entrySize, uint c)
+{
+    const uchar *data = reinterpret_cast<const uchar *>(dataFile.constData());
+    // every part ends where the next one begins
+    const quint32 offsetBegin = headerValue(dataFile, part);
+    const quint32 offsetEnd = headerValue(dataFile, part + 4);
+
+    int min = 0;
+    int max = ((offsetEnd - offsetBegin) / entrySize) - 1;
+
+    while (max >= min) {
+        const int mid = (min + max) / 2;
+        const quint32 midUnicode = qFromLittleEndian<quint32>(data + offsetBegin + mid * entrySize);
+        if (c > midUnicode) {
+            min = mid + 1;
+        } else if (c < midUnicode) {
+            max = mid - 1;
+        } else {
+            return offsetBegin + mid * entrySize;
+        }
+    }
+
+    return 0;
+}
+
+static QByteArray poolUtf8(const QByteArray &dataFile, quint32 id)
+{
+    const char *data = dataFile.constData();
+    const quint32 bucket = headerValue(dataFile, PoolBuckets) + (id / PoolBucketSize) * 4;
+    quint32 offset = headerValue(dataFile, PoolStrings) + qFromLittleEndian<quint32>(data + bucket);
+
+    // the first string of a bucket is complete, the others share a prefix with their predecessor
+    QByteArray string(data + offset);
+    offset += string.size() + 1;
+    for (quint32 i = 0, count = id % PoolBucketSize; i < count; ++i) {
+        const quint8 prefix = quint8(data[offset]);
+        const char *suffix = data + offset + 1;
+        const int suffixLength = qstrlen(suffix);
+        string.truncate(prefix);
+        string.append(suffix, suffixLength);
+        offset += suffixLength + 2;
+    }
+    return string;
+}
+
+static QString poolString(const QByteArray &dataFile, quint32 id)
+{
+    if (id == NoString) {
+        return QString();
+    }
+    return QString::fromUtf8(poolUtf8(dataFile, id));
+}
+
+static quint32 readVarint(const uchar *&data)
+{
+    quint32 value = 0;
+    int shift = 0;
+    while (*data & 0x80) {
+        value |= quint32(*data & 0x7F) << shift;
+        shift += 7;
+        ++data;
+    }
+    value |= quint32(*data) << shift;
+    ++data;
+    return value;
+}
+
+// adds the characters of all Unihan tokens starting with the UTF-8 encoded needle to result
+static void findUnihanTokens(const QByteArray &dataFile, const QByteArray &needle, QSet<uint> *result)
+{
+    const char *data = dataFile.constData();
+    const quint32 bucketsBegin = headerValue(dataFile, UnihanTokenBuckets);
+    const quint32 tokensBegin = headerValue(dataFile, UnihanTokens);
+    const quint32 postingsBegin = headerValue(dataFile, UnihanPostings);
+    const int bucketCount = (tokensBegin - bucketsBegin) / 4;
+    if (bucketCount == 0) {
+        return;
+    }
+
+    // the first token of a bucket is complete, find the first one not smaller than the needle;
+    // matching tokens may still be at the end of the bucket before it
+    int min = 0;
+    int max = bucketCount;
+    while (min < max) {
+        const int mid = (min + max) / 2;
+        // skip the shared prefix length, which is 0
+        const char *token = data + tokensBegin + headerValue(dataFile, bucketsBegin + mid * 4) + 1;
+        if (qstrcmp(token, needle.constData()) < 0) {
+            min = mid + 1;
+        } else {
+            max = mid;
+        }
+    }
+
+    quint32 offset = tokensBegin + headerValue(dataFile, bucketsBegin + qMax(0, min - 1) * 4);
+    QByteArray token;
+    while (offset < postingsBegin) {
+        const quint8 prefix = quint8(data[offset]);
+        const char *suffix = data + offset + 1;
+        const int suffixLength = qstrlen(suffix);
+        token.truncate(prefix);
+        token.append(suffix, suffixLength);
+        const quint32 postings = headerValue(dataFile, offset + 1 + suffixLength + 1);
+        offset += 1 + suffixLength + 1 + 4;
+
+        if (token.startsWith(needle)) {
+            const uchar *posting = reinterpret_cast<const uchar *>(data + postingsBegin + postings);
+            uint c = 0;
+            for (quint32 count = readVarint(posting); count > 0; --count) {
+                c += readVarint(posting);
+                result->insert(c);
+            }
+        } else if (token > needle) {
+            break;
+        }
+    }
+}
+
+static QList<quint32> detailList(const QByteArray &dataFile, quint32 detailEntry, DetailField field)
+{
+    const uchar *data = reinterpret_cast<const uchar *>(dataFile.constData());
+    quint32 offset = qFromLittleEndian<quint32>(data + detailEntry + 4 + field * 5);
+    const quint8 count = *(data + detailEntry + 4 + field * 5 + 4);
+
+    QList<quint32> values;
+    values.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        values.append(qFromLittleEndian<quint32>(data + offset));
+        offset += 4;
+    }
+    return values;
+}
+}
+
+qsizetype KCharSelectData::unihanIndexSize()
+{
+    if (!openDataFile() || formatVersion != 2) {
+        return 0;
+    }
+    return V2::headerValue(dataFile, V2::End) - V2::headerValue(dataFile, V2::UnihanTokenBuckets);
+}
+
 bool KCharSelectData::openDataFile()
 {
     if (!dataFile.isEmpty()) {
@@ -95,12 +321,30 @@ bool KCharSelectData::openDataFile()
             qWarning() << "Couldn't find " << kcharselectDataPath << " in the install prefix (under GenericDataLocation) nor in the builtin path" << TOP_SRCDIR;
             return false;
         }
-        dataFile = file.readAll();
-        file.close();
+        return loadDataFile(file.readAll());
+    }
+}
+
+bool KCharSelectData::loadDataFile(const QByteArray &fileContents)
+{
+    // the index of a previous data file may still be in creation
+    futureIndex.waitForFinished();
+
+    dataFile = fileContents;
+    if (dataFile.startsWith(V2::Magic)) {
+        if (!V2::isValid(dataFile)) {
+            dataFile.clear();
+            return false;
+        }
+        formatVersion = 2;
+        // code points are stored as they are
+        remapType = -1;
+    } else {
         if (dataFile.size() < 40) {
             dataFile.clear();
             return false;
         }
+        formatVersion = 1;
         const uchar *data = reinterpret_cast<const uchar *>(dataFile.constData());
         const quint32 offsetBegin = qFromLittleEndian<quint32>(data + 20);
         const quint32 offsetEnd = qFromLittleEndian<quint32>(data + 24);
@@ -116,12 +360,12 @@ bool KCharSelectData::openDataFile()
             dataFile.clear();
             return false;
         }
-        futureIndex = (new RunIndexCreation(this, dataFile))->start();
-        return true;
     }
+    futureIndex = (new RunIndexCreation(this, dataFile))->start();
+    return true;
 }
 
-// Temporary remapping code points <-> 16 bit database codes
+// Temporary remapping code points <-> 16 bit database codes of the version 1 format
 // See kcharselect-generate-datafile.py for details
 
 quint16 KCharSelectData::mapCodePointToDataBase(uint code) const
@@ -211,31 +455,60 @@ QString KCharSelectData::formatCode(uint code, int length, const QString &prefix
 }
 
 QList<uint> KCharSelectData::blockContents(int block)
+{
+    QList<uint> res;
+    const QList<Range> ranges = blockRanges(block);
+    for (const Range &range : ranges) {
+        for (uint c = range.first; c <= range.last; ++c) {
+            res.append(c);
+        }
+    }
+    return res;
+}
+
+QList<KCharSelectData::Range> KCharSelectData::blockRanges(int block)
 {
     if (!openDataFile()) {
-        return QList<uint>();
+        return QList<Range>();
     }
 
     const uchar *data = reinterpret_cast<const uchar *>(dataFile.constData());
+    QList<Range> res;
+
+    if (formatVersion == 2) {
+        const quint32 offsetBegin = V2::headerValue(dataFile, V2::Blocks);
+        const quint32 offsetEnd = V2::headerValue(dataFile, V2::SectionNames);
+        if (block < 0 || block >= int((offsetEnd - offsetBegin) / V2::BlockEntrySize)) {
+            return res;
+        }
+        const uchar *entry = data + offsetBegin + block * V2::BlockEntrySize;
+        res.append({qFromLittleEndian<quint32>(entry), qFromLittleEndian<quint32>(entry + 4)});
+        return res;
+    }
+
     const quint32 offsetBegin = qFromLittleEndian<quint32>(data + 20);
     const quint32 offsetEnd = qFromLittleEndian<quint32>(data + 24);
 
     int max = ((offsetEnd - offsetBegin) / 4) - 1;
 
-    QList<uint> res;
-
     if (block > max) {
         return res;
     }
 
-    quint16 unicodeBegin = qFromLittleEndian<quint16>(data + offsetBegin + block * 4);
-    quint16 unicodeEnd = qFromLittleEndian<quint16>(data + offsetBegin + block * 4 + 2);
+    uint unicodeBegin = qFromLittleEndian<quint16>(data + offsetBegin + block * 4);
+    const uint unicodeEnd = qFromLittleEndian<quint16>(data + offsetBegin + block * 4 + 2);
 
-    while (unicodeBegin < unicodeEnd) {
-        res.append(mapDataBaseToCodePoint(unicodeBegin));
-        unicodeBegin++;
+    // mapDataBaseToCodePoint() shifts the remapped areas by a constant,
+    // so the block is only split where one of them begins
+    if (remapType == 0) {
+        for (const uint boundary : {0xE000, 0xF000}) {
+            if (unicodeBegin < boundary && unicodeEnd >= boundary) {
+                res.append({mapDataBaseToCodePoint(unicodeBegin), mapDataBaseToCodePoint(boundary - 1)});
+                unicodeBegin = boundary;
+            }
+        }
     }
-    res.append(mapDataBaseToCodePoint(unicodeBegin)); // Be careful when unicodeEnd==0xffff
+    res.append({mapDataBaseToCodePoint(unicodeBegin), mapDataBaseToCodePoint(qMax(unicodeBegin, unicodeEnd))});
 
     return res;
 }
@@ -248,8 +521,10 @@ QList<int> KCharSelectData::sectionContents(int section)
     }
 
     const uchar *data = reinterpret_cast<const uchar *>(dataFile.constData());
-    const quint32 offsetBegin = qFromLittleEndian<quint32>(data + 28);
-    const quint32 offsetEnd = qFromLittleEndian<quint32>(data + 32);
+    // the section entries are the same in both formats
+    const int sectionsHeader = formatVersion == 2 ? V2::Sections : 28;
+    const quint32 offsetBegin = qFromLittleEndian<quint32>(data + sectionsHeader);
+    const quint32 offsetEnd = qFromLittleEndian<quint32>(data + sectionsHeader + 4);
 
     int max = ((offsetEnd - offsetBegin) / 4) - 1;
 
@@ -275,14 +550,25 @@ QStringList KCharSelectData::sectionList()
         return QStringList();
     }
 
+    QStringList list;
+    list.append(QCoreApplication::translate("KCharSelectData", "All", "KCharSelect section name"));
+
+    if (formatVersion == 2) {
+        const quint32 offsetBegin = V2::headerValue(dataFile, V2::SectionNames);
+        const quint32 offsetEnd = V2::headerValue(dataFile, V2::Sections);
+        for (quint32 offset = offsetBegin; offset < offsetEnd; offset += 4) {
+            const QByteArray name = V2::poolUtf8(dataFile, V2::headerValue(dataFile, offset));
+            list.append(QCoreApplication::translate("KCharSelectData", name.constData(), "KCharSelect section name"));
+        }
+        return list;
+    }
+
     const uchar *udata = reinterpret_cast<const uchar *>(dataFile.constData());
     const quint32 stringBegin = qFromLittleEndian<quint32>(udata + 24);
     const quint32 stringEnd = qFromLittleEndian<quint32>(udata + 28);
 
     const char *data = dataFile.constData();
-    QStringList list;
     quint32 i = stringBegin;
-    list.append(QCoreApplication::translate("KCharSelectData", "All", "KCharSelect section name"));
     while (i < stringEnd) {
         list.append(QCoreApplication::translate("KCharSelectData", data + i, "KCharSelect section name"));
         i += qstrlen(data + i) + 1;
@@ -339,6 +625,16 @@ QString KCharSelectData::name(uint c)
     } else if ((c >= 0xF900 && c <= 0xFAFF) || (c >= 0x2F800 && c <= 0x2FFFF)) {
         return QLatin1String("CJK COMPATIBILITY IDEOGRAPH-") + formatCode(c, 4, QString());
     }
+
+    if (formatVersion == 2) {
+        const quint32 entry = V2::findEntry(dataFile, V2::Names, V2::NameEntrySize, c);
+        if (entry == 0) {
+            return QCoreApplication::translate("KCharSelectData", "<not assigned>");
+        }
+        const quint32 nameAndCategory = V2::headerValue(dataFile, entry + 4);
+        return V2::poolString(dataFile, nameAndCategory & 0xFFFFFF);
+    }
+
     quint16 unicode = mapCodePointToDataBase(c);
     if (unicode == 0xFFFF) {
         return QLatin1String("NON-BMP-CHARACTER-") + formatCode(c, 4, QString());
@@ -381,6 +677,18 @@ int KCharSelectData::blockIndex(uint c)
     }
 
     const uchar *data = reinterpret_cast<const uchar *>(dataFile.constData());
+
+    if (formatVersion == 2) {
+        const quint32 offsetBegin = V2::headerValue(dataFile, V2::Blocks);
+        const quint32 offsetEnd = V2::headerValue(dataFile, V2::SectionNames);
+        const int max = ((offsetEnd - offsetBegin) / V2::BlockEntrySize) - 1;
+        int i = 0;
+        while (c > qFromLittleEndian<quint32>(data + offsetBegin + i * V2::BlockEntrySize + 4) && i < max) {
+            i++;
+        }
+        return i;
+    }
+
     const quint32 offsetBegin = qFromLittleEndian<quint32>(data + 20);
     const quint32 offsetEnd = qFromLittleEndian<quint32>(data + 24);
     const quint16 unicode = mapCodePointToDataBase(c);
@@ -406,8 +714,9 @@ int KCharSelectData::sectionIndex(int block)
     }
 
     const uchar *data = reinterpret_cast<const uchar *>(dataFile.constData());
-    const quint32 offsetBegin = qFromLittleEndian<quint32>(data + 28);
-    const quint32 offsetEnd = qFromLittleEndian<quint32>(data + 32);
+    const int sectionsHeader = formatVersion == 2 ? V2::Sections : 28;
+    const quint32 offsetBegin = qFromLittleEndian<quint32>(data + sectionsHeader);
+    const quint32 offsetEnd = qFromLittleEndian<quint32>(data + sectionsHeader + 4);
 
     int max = ((offsetEnd - offsetBegin) / 4) - 1;
 
@@ -426,6 +735,16 @@ QString KCharSelectData::blockName(int index)
         return QString();
     }
 
+    if (formatVersion == 2) {
+        const quint32 offsetBegin = V2::headerValue(dataFile, V2::Blocks);
+        const quint32 offsetEnd = V2::headerValue(dataFile, V2::SectionNames);
+        if (index < 0 || index >= int((offsetEnd - offsetBegin) / V2::BlockEntrySize)) {
+            return QString();
+        }
+        const QByteArray name = V2::poolUtf8(dataFile, V2::headerValue(dataFile, offsetBegin + index * V2::BlockEntrySize + 8));
+        return QCoreApplication::translate("KCharSelectData", name.constData(), "KCharselect unicode block name");
+    }
+
     const uchar *udata = reinterpret_cast<const uchar *>(dataFile.constData());
     const quint32 stringBegin = qFromLittleEndian<quint32>(udata + 16);
     const quint32 stringEnd = qFromLittleEndian<quint32>(udata + 20);
@@ -453,6 +772,16 @@ QString KCharSelectData::sectionName(int index)
 
     index -= 1;
 
+    if (formatVersion == 2) {
+        const quint32 offsetBegin = V2::headerValue(dataFile, V2::SectionNames);
+        const quint32 offsetEnd = V2::headerValue(dataFile, V2::Sections);
+        if (index < 0 || index >= int((offsetEnd - offsetBegin) / 4)) {
+            return QString();
+        }
+        const QByteArray name = V2::poolUtf8(dataFile, V2::headerValue(dataFile, offsetBegin + index * 4));
+        return QCoreApplication::translate("KCharSelectData", name.constData(), "KCharselect unicode section name");
+    }
+
     const uchar *udata = reinterpret_cast<const uchar *>(dataFile.constData());
     const quint32 stringBegin = qFromLittleEndian<quint32>(udata + 24);
     const quint32 stringEnd = qFromLittleEndian<quint32>(udata + 28);
@@ -474,6 +803,9 @@ QStringList KCharSelectData::aliases(uint c)
     if (!openDataFile()) {
         return QStringList();
     }
+    if (formatVersion == 2) {
+        return detailStrings(c, V2::Aliases);
+    }
     const uchar *udata = reinterpret_cast<const uchar *>(dataFile.constData());
     const int detailIndex = getDetailIndex(c);
     if (detailIndex == 0) {
@@ -499,6 +831,9 @@ QStringList KCharSelectData::notes(uint c)
     if (!openDataFile()) {
         return QStringList();
     }
+    if (formatVersion == 2) {
+        return detailStrings(c, V2::Notes);
+    }
     const int detailIndex = getDetailIndex(c);
     if (detailIndex == 0) {
         return QStringList();
@@ -525,6 +860,15 @@ QList<uint> KCharSelectData::seeAlso(uint c)
     if (!openDataFile()) {
         return QList<uint>();
     }
+    if (formatVersion == 2) {
+        const quint32 detailEntry = V2::findEntry(dataFile, V2::Details, V2::DetailEntrySize, c);
+        if (detailEntry == 0) {
+            return QList<uint>();
+        }
+        // the list holds the code points themselves
+        const QList<quint32> codePoints = V2::detailList(dataFile, detailEntry, V2::SeeAlso);
+        return QList<uint>(codePoints.cbegin(), codePoints.cend());
+    }
     const int detailIndex = getDetailIndex(c);
     if (detailIndex == 0) {
         return QList<uint>();
@@ -550,6 +894,9 @@ QStringList KCharSelectData::equivalents(uint c)
     if (!openDataFile()) {
         return QStringList();
     }
+    if (formatVersion == 2) {
+        return detailStrings(c, V2::Equivalents);
+    }
     const int detailIndex = getDetailIndex(c);
     if (detailIndex == 0) {
         return QStringList();
@@ -576,6 +923,9 @@ QStringList KCharSelectData::approximateEquivalents(uint c)
     if (!openDataFile()) {
         return QStringList();
     }
+    if (formatVersion == 2) {
+        return detailStrings(c, V2::ApproximateEquivalents);
+    }
     const int detailIndex = getDetailIndex(c);
     if (detailIndex == 0) {
         return QStringList();
@@ -597,6 +947,22 @@ QStringList KCharSelectData::approximateEquivalents(uint c)
     return approxEquivalents;
 }
 
+QStringList KCharSelectData::detailStrings(uint c, int field)
+{
+    const quint32 detailEntry = V2::findEntry(dataFile, V2::Details, V2::DetailEntrySize, c);
+    if (detailEntry == 0) {
+        return QStringList();
+    }
+
+    const QList<quint32> ids = V2::detailList(dataFile, detailEntry, V2::DetailField(field));
+    QStringList strings;
+    strings.reserve(ids.size());
+    for (quint32 id : ids) {
+        strings.append(V2::poolString(dataFile, id));
+    }
+    return strings;
+}
+
 QList<uint> KCharSelectData::decomposition(uint c)
 {
     // for now, only decompose Hangul Syllable into Hangul Jamo
@@ -623,6 +989,19 @@ QStringList KCharSelectData::unihanInfo(uint c)
         return QStringList();
     }
 
+    if (formatVersion == 2) {
+        const quint32 entry = V2::findEntry(dataFile, V2::Unihan, V2::UnihanEntrySize, c);
+        if (entry == 0) {
+            return QStringList();
+        }
+        QStringList res;
+        res.reserve(V2::UnihanFields);
+        for (int i = 0; i < V2::UnihanFields; i++) {
+            res.append(V2::poolString(dataFile, V2::headerValue(dataFile, entry + 4 + i * 4)));
+        }
+        return res;
+    }
+
     quint16 unicode = mapCodePointToDataBase(c);
     if (unicode == 0xFFFF) {
         return QStringList();
@@ -668,6 +1047,16 @@ QChar::Category KCharSelectData::category(uint c)
         return QChar::category(c);
     }
 
+    if (formatVersion == 2) {
+        const quint32 entry = V2::findEntry(dataFile, V2::Names, V2::NameEntrySize, c);
+        if (entry == 0) {
+            return QChar::category(c);
+        }
+        const uchar categoryCode = V2::headerValue(dataFile, entry + 4) >> 24;
+        Q_ASSERT(categoryCode > 0);
+        return QChar::Category(categoryCode - 1);
+    }
+
     ushort unicode = mapCodePointToDataBase(c);
     if (unicode == 0xFFFF) {
         return QChar::category(c);
@@ -949,18 +1338,34 @@ QSet<uint> KCharSelectData::getMatchingChars(const QString &s)
     if (dataFile.isEmpty()) {
         return QSet<uint>();
     }
-    futureIndex.waitForFinished();
+    {
+        KTRACE_SCOPE("KCharSelectData::waitForIndex");
+        futureIndex.waitForFinished();
+    }
     const Index index = futureIndex.result();
-    Index::const_iterator pos = index.lowerBound(s);
     QSet<uint> result;
 
-    while (pos != index.constEnd() && pos.key().startsWith(s)) {
+    auto pos = index.databaseCodes.lowerBound(s);
+    while (pos != index.databaseCodes.constEnd() && pos.key().startsWith(s)) {
         for (quint16 c : pos.value()) {
             result.insert(mapDataBaseToCodePoint(c));
         }
         ++pos;
     }
 
+    auto codePointPos = index.codePoints.lowerBound(s);
+    while (codePointPos != index.codePoints.constEnd() && codePointPos.key().startsWith(s)) {
+        for (uint c : codePointPos.value()) {
+            result.insert(c);
+        }
+        ++codePointPos;
+    }
+
+    // the Unihan data is too large for the index, it is searched in the data file itself
+    if (formatVersion == 2) {
+        V2::findUnihanTokens(dataFile, s.toUtf8(), &result);
+    }
+
     return result;
 }
 
@@ -986,18 +1391,51 @@ QStringList KCharSelectData::splitString(const QString &s)
     return result;
 }
 
-void KCharSelectData::appendToIndex(Index *index, quint16 unicode, const QString &s)
+template<typename Code>
+void KCharSelectData::appendToIndex(QMap<QString, QList<Code>> *index, Code code, const QString &s)
 {
     const QStringList strings = splitString(s);
     for (const QString &s : strings) {
-        (*index)[s.toLower()].append(unicode);
+        (*index)[s.toLower()].append(code);
     }
 }
 
 Index KCharSelectData::createIndex(const QByteArray &dataFile)
 {
+    KTRACE_SCOPE("KCharSelectData::createIndex");
     Index i;
 
+    if (dataFile.startsWith(V2::Magic)) {
+        // character names
+        const quint32 namesBegin = V2::headerValue(dataFile, V2::Names);
+        const quint32 namesEnd = V2::headerValue(dataFile, V2::Details);
+        for (quint32 entry = namesBegin; entry < namesEnd; entry += V2::NameEntrySize) {
+            const uint unicode = V2::headerValue(dataFile, entry);
+            appendToIndex(&i.codePoints, unicode, V2::poolString(dataFile, V2::headerValue(dataFile, entry + 4) & 0xFFFFFF));
+        }
+
+        // details
+        const quint32 detailsBegin = V2::headerValue(dataFile, V2::Details);
+        const quint32 detailsEnd = V2::headerValue(dataFile, V2::Lists);
+        for (quint32 entry = detailsBegin; entry < detailsEnd; entry += V2::DetailEntrySize) {
+            const uint unicode = V2::headerValue(dataFile, entry);
+            for (V2::DetailField field : {V2::Aliases, V2::Notes, V2::ApproximateEquivalents, V2::Equivalents}) {
+                const QList<quint32> ids = V2::detailList(dataFile, entry, field);
+                for (quint32 id : ids) {
+                    appendToIndex(&i.codePoints, unicode, V2::poolString(dataFile, id));
+                }
+            }
+            // see also - convert to string (hex)
+            const QList<quint32> seeAlso = V2::detailList(dataFile, entry, V2::SeeAlso);
+            for (quint32 codePoint : seeAlso) {
+                appendToIndex(&i.codePoints, unicode, formatCode(codePoint, 4, QString()));
+            }
+        }
+
+        KTRACE_COUNTER("KCharSelectData index keys", i.codePoints.size());
+        return i;
+    }
+
     // character names
     const uchar *udata = reinterpret_cast<const uchar *>(dataFile.constData());
     const char *data = dataFile.constData();
@@ -1009,7 +1447,7 @@ Index KCharSelectData::createIndex(const QByteArray &dataFile)
     for (int pos = 0; pos <= max; pos++) {
         const quint16 unicode = qFromLittleEndian<quint16>(udata + nameOffsetBegin + pos * 6);
         quint32 offset = qFromLittleEndian<quint32>(udata + nameOffsetBegin + pos * 6 + 2);
-        appendToIndex(&i, unicode, QString::fromUtf8(data + offset + 1));
+        appendToIndex(&i.databaseCodes, unicode, QString::fromUtf8(data + offset + 1));
     }
 
     // details
@@ -1026,7 +1464,7 @@ Index KCharSelectData::createIndex(const QByteArray &dataFile)
         quint32 aliasOffset = qFromLittleEndian<quint32>(udata + detailsOffsetBegin + pos * 27 + 2);
 
         for (int j = 0; j < aliasCount; j++) {
-            appendToIndex(&i, unicode, QString::fromUtf8(data + aliasOffset));
+            appendToIndex(&i.databaseCodes, unicode, QString::fromUtf8(data + aliasOffset));
             aliasOffset += qstrlen(data + aliasOffset) + 1;
         }
 
@@ -1035,7 +1473,7 @@ Index KCharSelectData::createIndex(const QByteArray &dataFile)
         quint32 notesOffset = qFromLittleEndian<quint32>(udata + detailsOffsetBegin + pos * 27 + 7);
 
         for (int j = 0; j < notesCount; j++) {
-            appendToIndex(&i, unicode, QString::fromUtf8(data + notesOffset));
+            appendToIndex(&i.databaseCodes, unicode, QString::fromUtf8(data + notesOffset));
             notesOffset += qstrlen(data + notesOffset) + 1;
         }
 
@@ -1044,7 +1482,7 @@ Index KCharSelectData::createIndex(const QByteArray &dataFile)
         quint32 apprOffset = qFromLittleEndian<quint32>(udata + detailsOffsetBegin + pos * 27 + 12);
 
         for (int j = 0; j < apprCount; j++) {
-            appendToIndex(&i, unicode, QString::fromUtf8(data + apprOffset));
+            appendToIndex(&i.databaseCodes, unicode, QString::fromUtf8(data + apprOffset));
             apprOffset += qstrlen(data + apprOffset) + 1;
         }
 
@@ -1053,7 +1491,7 @@ Index KCharSelectData::createIndex(const QByteArray &dataFile)
         quint32 equivOffset = qFromLittleEndian<quint32>(udata + detailsOffsetBegin + pos * 27 + 17);
 
         for (int j = 0; j < equivCount; j++) {
-            appendToIndex(&i, unicode, QString::fromUtf8(data + equivOffset));
+            appendToIndex(&i.databaseCodes, unicode, QString::fromUtf8(data + equivOffset));
             equivOffset += qstrlen(data + equivOffset) + 1;
         }
 
@@ -1063,13 +1501,14 @@ Index KCharSelectData::createIndex(const QByteArray &dataFile)
 
         for (int j = 0; j < seeAlsoCount; j++) {
             quint16 seeAlso = qFromLittleEndian<quint16>(udata + seeAlsoOffset);
-            appendToIndex(&i, unicode, formatCode(seeAlso, 4, QString()));
+            appendToIndex(&i.databaseCodes, unicode, formatCode(seeAlso, 4, QString()));
             equivOffset += qstrlen(data + equivOffset) + 1;
         }
     }
 
     // unihan data
-    // temporary disabled due to the huge amount of data
+    // temporary disabled due to the huge amount of data,
+    // the version 2 format has a token index for it instead
     // const quint32 unihanOffsetBegin = qFromLittleEndian<quint32>(udata+36);
     // const quint32 unihanOffsetEnd = dataFile.size();
     // max = ((unihanOffsetEnd - unihanOffsetBegin) / 30) - 1;
@@ -1084,5 +1523,6 @@ Index KCharSelectData::createIndex(const QByteArray &dataFile)
     //     }
     // }
 
+    KTRACE_COUNTER("KCharSelectData index keys", i.databaseCodes.size());
     return i;
 }
@@ -17,14 +17,27 @@
 
 // Internal class used by KCharSelect
 
-typedef QMap<QString, QList<quint16>> Index;
+// The search index maps lowercase words to characters. The 16 bit database codes
+// of the version 1 format are kept as they are and only mapped to code points when
+// searching, the version 2 format needs the full code points.
+struct Index {
+    QMap<QString, QList<quint16>> databaseCodes;
+    QMap<QString, QList<uint>> codePoints;
+};
 
 class KCharSelectData
 {
 public:
+    /** A range of consecutive code points, both ends included. */
+    struct Range {
+        uint first;
+        uint last;
+    };
+
     QString formatCode(uint code, int length = 4, const QString &prefix = QStringLiteral("U+"), int base = 16);
 
     QList<uint> blockContents(int block);
+    QList<Range> blockRanges(int block);
     QList<int> sectionContents(int section);
 
     QStringList sectionList();
@@ -60,20 +73,38 @@ public:
 
     QList<uint> find(const QString &s);
 
+    /**
+     * Uses @p fileContents instead of the installed data file, for the autotests.
+     * Both the version 1 and the version 2 format are supported. The installed
+     * data file is still version 1, so only the autotests read version 2 so far.
+     * @return false if @p fileContents is not a supported data file
+     */
+    bool loadDataFile(const QByteArray &fileContents);
+
+    /**
+     * Size of the Unihan token index in bytes, 0 if the data file has none.
+     * The index is searched in place, so this is all the memory it needs.
+     */
+    qsizetype unihanIndexSize();
+
 private:
     bool openDataFile();
     quint32 getDetailIndex(uint c) const;
     QSet<uint> getMatchingChars(const QString &s);
 
     QStringList splitString(const QString &s);
-    void appendToIndex(Index *index, quint16 unicode, const QString &s);
+    template<typename Code>
+    void appendToIndex(QMap<QString, QList<Code>> *index, Code code, const QString &s);
     Index createIndex(const QByteArray &dataFile);
 
     quint16 mapCodePointToDataBase(uint code) const;
     uint mapDataBaseToCodePoint(quint16 code) const;
 
+    QStringList detailStrings(uint c, int field);
+
     QByteArray dataFile;
     QFuture<Index> futureIndex;
+    int formatVersion = 0;
     int remapType;
     friend class RunIndexCreation;
 };
@@ -6,6 +6,7 @@
 */
 
 #include "kcollapsiblegroupbox.h"
+#include "ktracing_p.h"
 
 #include <QLabel>
 #include <QLayout>
@@ -47,6 +48,7 @@ KCollapsibleGroupBox::KCollapsibleGroupBox(QWidget *parent)
 
     d->animation = new QTimeLine(500, this); // duration matches kmessagewidget
     connect(d->animation, &QTimeLine::valueChanged, this, [this](qreal value) {
+        KTRACE_COUNT("KCollapsibleGroupBox animation ticks");
         setFixedHeight((d->contentSize().height() * value) + d->headerSize.height());
     });
     connect(d->animation, &QTimeLine::stateChanged, this, [this](QTimeLine::State state) {
@@ -10,8 +10,10 @@
 #include "kcolorcombo.h"
 
 #include <QAbstractItemDelegate>
+#include <QAbstractListModel>
 #include <QApplication>
 #include <QColorDialog>
+#include <QPixmapCache>
 #include <QStylePainter>
 
 class KColorComboDelegate : public QAbstractItemDelegate
@@ -45,6 +47,26 @@ static QBrush k_colorcombodelegate_brush(const QModelIndex &index, int role)
     return brush;
 }
 
+// Swatches are shared by all color combos, palettes often have a lot of colors
+static QPixmap k_colorcombodelegate_swatch(const QColor &color, const QSize &size, qreal dpr)
+{
+    const QString key = QStringLiteral("kcolorcombo-swatch-%1-%2x%3@%4").arg(color.rgba(), 0, 16).arg(size.width()).arg(size.height()).arg(dpr);
+    QPixmap pixmap;
+    if (!QPixmapCache::find(key, &pixmap)) {
+        pixmap = QPixmap(size * dpr);
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::transparent);
+        painter.setBrush(color);
+        painter.drawRoundedRect(QRect(QPoint(0, 0), size), 2, 2);
+        painter.end();
+        QPixmapCache::insert(key, pixmap);
+    }
+    return pixmap;
+}
+
 KColorComboDelegate::KColorComboDelegate(QObject *parent)
     : QAbstractItemDelegate(parent)
 {
@@ -78,13 +100,7 @@ void KColorComboDelegate::paint(QPainter *painter, const QStyleOptionViewItem &o
         if (tmpcolor.isValid()) {
             innercolor = tmpcolor;
             paletteBrush = false;
-            painter->setPen(Qt::transparent);
-            painter->setBrush(innercolor);
-            QPainter::RenderHints tmpHint = painter->renderHints();
-            painter->setRenderHint(QPainter::Antialiasing);
-            painter->drawRoundedRect(innerrect, 2, 2);
-            painter->setRenderHints(tmpHint);
-            painter->setBrush(Qt::NoBrush);
+            painter->drawPixmap(innerrect.topLeft(), k_colorcombodelegate_swatch(innercolor, innerrect.size(), painter->device()->devicePixelRatio()));
         }
     }
     // text
@@ -121,6 +137,109 @@ QSize KColorComboDelegate::sizeHint(const QStyleOptionViewItem &option, const QM
     return QSize(100, option.fontMetrics.height() + 2 * FrameMargin);
 }
 
+/**
+ * The entries of the combo: the custom color entry followed by the colors to choose from.
+ * Replacing all the colors is done with a single model reset.
+ */
+class KColorComboModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    explicit KColorComboModel(QObject *parent = nullptr)
+        : QAbstractListModel(parent)
+    {
+    }
+
+    void setColors(const QString &customText, const QList<QColor> &colors, const QStringList &names)
+    {
+        beginResetModel();
+        m_entries.clear();
+        m_entries.reserve(colors.size() + 1);
+        m_entries.append({QColor(), customText});
+        for (int i = 0, count = colors.size(); i < count; ++i) {
+            m_entries.append({colors.at(i), names.value(i)});
+        }
+        endResetModel();
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_entries.size();
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+            return QVariant();
+        }
+
+        const Entry &entry = m_entries.at(index.row());
+        switch (role) {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            return entry.name;
+        case Qt::ToolTipRole:
+            return entry.name.isEmpty() ? QVariant() : QVariant(entry.name);
+        case KColorComboDelegate::ColorRole:
+            return entry.color.isValid() ? QVariant::fromValue(entry.color) : QVariant();
+        default:
+            return QVariant();
+        }
+    }
+
+    bool setData(const QModelIndex &index, const QVariant &value, int role) override
+    {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+            return false;
+        }
+
+        Entry &entry = m_entries[index.row()];
+        switch (role) {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            entry.name = value.toString();
+            break;
+        case KColorComboDelegate::ColorRole:
+            entry.color = value.value<QColor>();
+            break;
+        default:
+            return false;
+        }
+        Q_EMIT dataChanged(index, index, {role});
+        return true;
+    }
+
+    // needed by QComboBox::insertItem() and QComboBox::clear()
+    bool insertRows(int row, int count, const QModelIndex &parent = QModelIndex()) override
+    {
+        if (parent.isValid() || row < 0 || row > m_entries.size() || count <= 0) {
+            return false;
+        }
+        beginInsertRows(parent, row, row + count - 1);
+        m_entries.insert(row, count, Entry());
+        endInsertRows();
+        return true;
+    }
+
+    bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override
+    {
+        if (parent.isValid() || row < 0 || count <= 0 || row + count > m_entries.size()) {
+            return false;
+        }
+        beginRemoveRows(parent, row, row + count - 1);
+        m_entries.remove(row, count);
+        endRemoveRows();
+        return true;
+    }
+
+private:
+    struct Entry {
+        QColor color;
+        QString name;
+    };
+    QList<Entry> m_entries;
+};
+
 static const uchar standardPalette[][4] = {
     {255, 255, 255}, // white
     {192, 192, 192}, // light gray
@@ -172,13 +291,16 @@ public:
     void slotHighlighted(int index);
 
     KColorCombo *q;
+    KColorComboModel *model;
     QList<QColor> colorList;
+    QStringList colorNames;
     QColor customColor;
     QColor internalcolor;
 };
 
 KColorComboPrivate::KColorComboPrivate(KColorCombo *qq)
     : q(qq)
+    , model(new KColorComboModel(qq))
     , customColor(Qt::white)
 {
 }
@@ -213,6 +335,7 @@ KColorCombo::KColorCombo(QWidget *parent)
     : QComboBox(parent)
     , d(new KColorComboPrivate(this))
 {
+    setModel(d->model);
     setItemDelegate(new KColorComboDelegate(this));
     d->addColors();
 
@@ -234,8 +357,13 @@ KColorCombo::~KColorCombo() = default;
 
 void KColorCombo::setColors(const QList<QColor> &colors)
 {
-    clear();
+    setColors(colors, QStringList());
+}
+
+void KColorCombo::setColors(const QList<QColor> &colors, const QStringList &names)
+{
     d->colorList = colors;
+    d->colorNames = names;
     d->addColors();
 }
 
@@ -330,18 +458,17 @@ void KColorComboPrivate::slotHighlighted(int index)
 
 void KColorComboPrivate::addColors()
 {
-    q->addItem(KColorCombo::tr("Custom...", "@item:inlistbox Custom color"));
+    const QString customText = KColorCombo::tr("Custom...", "@item:inlistbox Custom color");
 
     if (colorList.isEmpty()) {
-        for (int i = 0; i < STANDARD_PALETTE_SIZE; ++i) {
-            q->addItem(QString());
-            q->setItemData(i + 1, standardColor(i), KColorComboDelegate::ColorRole);
-        }
+        model->setColors(customText, q->colors(), QStringList());
     } else {
-        for (int i = 0, count = colorList.count(); i < count; ++i) {
-            q->addItem(QString());
-            q->setItemData(i + 1, colorList[i], KColorComboDelegate::ColorRole);
-        }
+        model->setColors(customText, colorList, colorNames);
+    }
+
+    // like the first item added to an empty combo
+    if (q->currentIndex() < 0) {
+        q->setCurrentIndex(0);
     }
 }
 
@@ -68,6 +68,21 @@ public:
      */
     void setColors(const QList<QColor> &colors);
 
+    /**
+     * Set a custom list of named colors to choose from, in place of the
+     * standard list, e.g. the colors of a GIMP or Inkscape palette.
+     *
+     * The names are shown on the colors, and the user can select a color
+     * by typing the beginning of its name.
+     *
+     * @param colors list of colors. If empty, the selection list reverts to
+     *             the standard list.
+     * @param names names of the colors, in the same order as @p colors.
+     *             Missing names are left empty.
+     * @since 6.0
+     */
+    void setColors(const QList<QColor> &colors, const QStringList &names);
+
     /**
      * Return the list of colors available for selection.
      * @return list of colors
@@ -13,6 +13,7 @@
 #include "kdatepicker_p.h"
 
 #include "common_helpers_p.h"
+#include "kcalendarmonth_p.h"
 #include "kdatetable_p.h"
 #include <kpopupframe.h>
 
@@ -169,50 +170,41 @@ public:
 
     /// the font size for the widget
     int fontsize = -1;
+
+    /// the year and locale the week combo was filled for
+    int weeksComboYear = 0;
+    QLocale weeksComboLocale;
 };
 
 void KDatePickerPrivate::fillWeeksCombo()
 {
     // every year can have a different number of weeks
     // it could be that we had 53,1..52 and now 1..53 which is the same number but different
-    // so always fill with new values
+    // so refill whenever the year changes
     // We show all week numbers for all weeks between first day of year to last day of year
     // This of course can be a list like 53,1,2..52
 
-    const QDate thisDate = q->date();
-    const int thisYear = thisDate.year();
-    QDate day(thisDate.year(), 1, 1);
-    const QDate lastDayOfYear = QDate(thisDate.year() + 1, 1, 1).addDays(-1);
+    const int thisYear = q->date().year();
+    const QLocale locale = q->locale();
+    if (selectWeek->count() > 0 && weeksComboYear == thisYear && weeksComboLocale == locale) {
+        return;
+    }
+    weeksComboYear = thisYear;
+    weeksComboLocale = locale;
 
     selectWeek->clear();
 
-    // Starting from the first day in the year, loop through the year a week at a time
-    // adding an entry to the week combo for each week in the year
-
-    for (; day.isValid() && day <= lastDayOfYear; day = day.addDays(7)) {
-        // Get the ISO week number for the current day and what year that week is in
-        // e.g. 1st day of this year may fall in week 53 of previous year
-        int weekYear = thisYear;
-        const int week = day.weekNumber(&weekYear);
-        QString weekString = tr("Week %1").arg(q->locale().toString(week));
+    const QList<KCalendarMonth::Week> weeks = KCalendarMonth::weeksOfYear(thisYear);
+    for (const KCalendarMonth::Week &week : weeks) {
+        QString weekString = tr("Week %1").arg(locale.toString(week.number));
 
         // show that this is a week from a different year
-        if (weekYear != thisYear) {
+        if (week.year != thisYear) {
             weekString += QLatin1Char('*');
         }
 
-        // when the week is selected, go to the same weekday as the one
-        // that is currently selected in the date table
-        QDate targetDate = day.addDays(thisDate.dayOfWeek() - day.dayOfWeek());
-        selectWeek->addItem(weekString, targetDate);
-
-        // make sure that the week of the lastDayOfYear is always inserted: in Chinese calendar
-        // system, this is not always the case
-        if (day < lastDayOfYear //
-            && day.daysTo(lastDayOfYear) < 7 //
-            && lastDayOfYear.weekNumber() != day.weekNumber()) {
-            day = lastDayOfYear.addDays(-7);
-        }
+        // weekSelected() goes to the same weekday as the one currently selected in the date table
+        selectWeek->addItem(weekString, week.firstDay);
     }
 }
 
@@ -449,7 +441,9 @@ void KDatePicker::yearBackwardClicked()
 
 void KDatePicker::weekSelected(int index)
 {
-    QDate targetDay = d->selectWeek->itemData(index).toDateTime().date();
+    // go to the same weekday as the one that is currently selected in the date table
+    const QDate day = d->selectWeek->itemData(index).toDate();
+    const QDate targetDay = day.addDays(date().dayOfWeek() - day.dayOfWeek());
 
     if (!setDate(targetDay)) {
         QApplication::beep();
@@ -51,12 +51,14 @@ public:
     }
 
     void addMenuAction(const QString &text, const QDate &date);
+    KDatePicker *datePicker();
     void buildMenu();
     void menuActionTriggered(QAction *action);
     void slotDateChanged(QDate);
 
     KDatePickerPopup *const q;
     KDatePicker *mDatePicker = nullptr;
+    QDate mDate;
     KDatePickerPopup::Modes mModes;
     QMap<QDate, QString> m_dateMap;
 };
@@ -78,12 +80,32 @@ void KDatePickerPopupPrivate::addMenuAction(const QString &text, const QDate &da
     q->addAction(action);
 }
 
+KDatePicker *KDatePickerPopupPrivate::datePicker()
+{
+    // The picker with its date table and month/year/week controls is comparatively
+    // expensive, and most popups (e.g. those of KDateComboBox) are never shown,
+    // so only create it once it is actually needed.
+    if (!mDatePicker) {
+        mDatePicker = new KDatePicker(q);
+        mDatePicker->setCloseButton(false);
+        mDatePicker->setDate(mDate);
+
+        QObject::connect(mDatePicker, &KDatePicker::dateEntered, q, [this](QDate date) {
+            slotDateChanged(date);
+        });
+        QObject::connect(mDatePicker, &KDatePicker::dateSelected, q, [this](QDate date) {
+            slotDateChanged(date);
+        });
+    }
+    return mDatePicker;
+}
+
 void KDatePickerPopupPrivate::buildMenu()
 {
     q->clear();
 
     if (mModes & KDatePickerPopup::DatePicker) {
-        q->addAction(new KDatePickerAction(mDatePicker, q));
+        q->addAction(new KDatePickerAction(datePicker(), q));
 
         if ((mModes & KDatePickerPopup::NoDate) || (mModes & KDatePickerPopup::Words)) {
             q->addSeparator();
@@ -135,18 +157,7 @@ KDatePickerPopup::KDatePickerPopup(Modes modes, QDate date, QWidget *parent)
     , d(new KDatePickerPopupPrivate(this))
 {
     d->mModes = modes;
-
-    d->mDatePicker = new KDatePicker(this);
-    d->mDatePicker->setCloseButton(false);
-
-    connect(d->mDatePicker, &KDatePicker::dateEntered, this, [this](QDate date) {
-        d->slotDateChanged(date);
-    });
-    connect(d->mDatePicker, &KDatePicker::dateSelected, this, [this](QDate date) {
-        d->slotDateChanged(date);
-    });
-
-    d->mDatePicker->setDate(date);
+    d->mDate = date;
 
     connect(this, &QMenu::aboutToShow, this, [this]() {
         d->buildMenu();
@@ -157,12 +168,15 @@ KDatePickerPopup::~KDatePickerPopup() = default;
 
 KDatePicker *KDatePickerPopup::datePicker() const
 {
-    return d->mDatePicker;
+    return d->datePicker();
 }
 
 void KDatePickerPopup::setDate(QDate date)
 {
-    d->mDatePicker->setDate(date);
+    d->mDate = date;
+    if (d->mDatePicker) {
+        d->mDatePicker->setDate(date);
+    }
 }
 
 KDatePickerPopup::Modes KDatePickerPopup::modes() const
@@ -8,6 +8,7 @@
 */
 
 #include "kdatetable_p.h"
+#include "kcalendarmonth_p.h"
 
 #include <QAction>
 #include <QActionEvent>
@@ -38,6 +39,7 @@ public:
     }
 
     void setDate(const QDate &date);
+    const KCalendarMonth &month();
     void nextMonth();
     void previousMonth();
     void beginningOfMonth();
@@ -53,14 +55,9 @@ public:
     QDate m_date;
 
     /**
-     * The weekday number of the first day in the month [1..daysInWeek()].
+     * The layout of the current month, shared with other date tables.
      */
-    int m_weekDayFirstOfMonth;
-
-    /**
-     * The number of days in the current month.
-     */
-    int m_numDaysThisMonth;
+    std::shared_ptr<const KCalendarMonth> m_month;
 
     /**
      * Save the size of the largest used cell content.
@@ -181,29 +178,12 @@ void KDateTable::initAccels()
 
 int KDateTable::posFromDate(const QDate &date)
 {
-    int initialPosition = date.day();
-    int offset = (d->m_weekDayFirstOfMonth - locale().firstDayOfWeek() + d->m_numDayColumns) % d->m_numDayColumns;
-
-    // make sure at least one day of the previous month is visible.
-    // adjust this < 1 if more days should be forced visible:
-    if (offset < 1) {
-        offset += d->m_numDayColumns;
-    }
-
-    return initialPosition + offset;
+    return d->month().position(date);
 }
 
 QDate KDateTable::dateFromPos(int position)
 {
-    int offset = (d->m_weekDayFirstOfMonth - locale().firstDayOfWeek() + d->m_numDayColumns) % d->m_numDayColumns;
-
-    // make sure at least one day of the previous month is visible.
-    // adjust this < 1 if more days should be forced visible:
-    if (offset < 1) {
-        offset += d->m_numDayColumns;
-    }
-
-    return QDate(d->m_date.year(), d->m_date.month(), 1).addDays(position - offset);
+    return d->month().date(position);
 }
 
 void KDateTable::paintEvent(QPaintEvent *e)
@@ -246,32 +226,14 @@ void KDateTable::paintCell(QPainter *painter, int row, int col)
     QColor cellBackgroundColor;
     QColor cellTextColor;
     QFont cellFont = QFontDatabase::systemFont(QFontDatabase::GeneralFont);
-    bool workingDay = false;
-    int cellWeekDay;
+    const KCalendarMonth &month = d->month();
     int pos;
 
     // Calculate the position of the cell in the grid
     pos = d->m_numDayColumns * (row - 1) + col;
 
-    // Calculate what day of the week the cell is
-    if (col + locale().firstDayOfWeek() <= d->m_numDayColumns) {
-        cellWeekDay = col + locale().firstDayOfWeek();
-    } else {
-        cellWeekDay = col + locale().firstDayOfWeek() - d->m_numDayColumns;
-    }
-
-    // FIXME This is wrong if the widget is not using the global!
     // See if cell day is normally a working day
-    if (locale().weekdays().first() <= locale().weekdays().last()) {
-        if (cellWeekDay >= locale().weekdays().first() && cellWeekDay <= locale().weekdays().last()) {
-            workingDay = true;
-        }
-    } else {
-        if (cellWeekDay >= locale().weekdays().first() //
-            || cellWeekDay <= locale().weekdays().last()) {
-            workingDay = true;
-        }
-    }
+    const bool workingDay = month.isWorkingDay(col);
 
     if (row == 0) {
         // We are drawing a header cell
@@ -286,22 +248,18 @@ void KDateTable::paintCell(QPainter *painter, int row, int col)
 
         // Set the text to the short day name and bold it
         cellFont.setBold(true);
-        cellText = locale().dayName(cellWeekDay, QLocale::ShortFormat);
+        cellText = month.shortDayName(col);
 
     } else {
         // We are drawing a day cell
 
         // Calculate the date the cell represents
-        QDate cellDate = dateFromPos(pos);
+        QDate cellDate = month.date(pos);
 
         bool validDay = cellDate.isValid();
 
         // Draw the day number in the cell, if the date is not valid then we don't want to show it
-        if (validDay) {
-            cellText = locale().toString(cellDate.day());
-        } else {
-            cellText = QString();
-        }
+        cellText = month.dayLabel(pos);
 
         if (!validDay || cellDate.month() != d->m_date.month()) {
             // we are either
@@ -510,8 +468,9 @@ void KDateTable::setFontSize(int size)
     // ----- find largest day name:
     d->m_maxCell.setWidth(0);
     d->m_maxCell.setHeight(0);
-    for (int weekday = 1; weekday <= 7; ++weekday) {
-        rect = metrics.boundingRect(locale().dayName(weekday, QLocale::ShortFormat));
+    const KCalendarMonth &month = d->month();
+    for (int column = 0; column < KCalendarMonth::Columns; ++column) {
+        rect = metrics.boundingRect(month.shortDayName(column));
         d->m_maxCell.setWidth(qMax(d->m_maxCell.width(), rect.width()));
         d->m_maxCell.setHeight(qMax(d->m_maxCell.height(), rect.height()));
     }
@@ -618,9 +577,17 @@ void KDateTable::mousePressEvent(QMouseEvent *e)
 void KDateTable::KDateTablePrivate::setDate(const QDate &date)
 {
     m_date = date;
-    m_weekDayFirstOfMonth = QDate(date.year(), date.month(), 1).dayOfWeek();
-    m_numDaysThisMonth = m_date.daysInMonth();
-    m_numDayColumns = 7;
+    m_numDayColumns = KCalendarMonth::Columns;
+}
+
+const KCalendarMonth &KDateTable::KDateTablePrivate::month()
+{
+    // the locale can change at any time, so check it along with the month
+    const QLocale locale = q->locale();
+    if (!m_month || m_month->year() != m_date.year() || m_month->month() != m_date.month() || m_month->locale() != locale) {
+        m_month = KCalendarMonth::get(m_date.year(), m_date.month(), locale);
+    }
+    return *m_month;
 }
 
 bool KDateTable::setDate(const QDate &toDate)
@@ -12,6 +12,107 @@
 
 #include "ui_kdatetimeedit.h"
 
+#include <QAbstractListModel>
+
+// The ids of all the time zones known to the system. Building the list and
+// especially the QTimeZone objects is not free, so both are only created when
+// first needed and then shared by all KDateTimeEdit instances.
+static const QList<QByteArray> &systemTimeZoneIds()
+{
+    static const QList<QByteArray> zoneIds = QTimeZone::availableTimeZoneIds();
+    return zoneIds;
+}
+
+static const QList<QTimeZone> &systemTimeZones()
+{
+    static const QList<QTimeZone> zones = []() {
+        const QList<QByteArray> &zoneIds = systemTimeZoneIds();
+        QList<QTimeZone> zones;
+        zones.reserve(zoneIds.size());
+        for (const QByteArray &zoneId : zoneIds) {
+            zones << QTimeZone(zoneId);
+        }
+        return zones;
+    }();
+    return zones;
+}
+
+// Model for the time zone combo box: "UTC" and "Floating" followed by the
+// zone ids, which are only added once the user interacts with the combo box.
+class KDateTimeEditTimeZoneModel : public QAbstractListModel
+{
+public:
+    using QAbstractListModel::QAbstractListModel;
+
+    void populate()
+    {
+        if (m_populated) {
+            return;
+        }
+
+        const QList<QByteArray> &zoneIds = m_hasCustomZoneIds ? m_zoneIds : systemTimeZoneIds();
+        if (!zoneIds.isEmpty()) {
+            beginInsertRows(QModelIndex(), FixedRowCount, FixedRowCount + zoneIds.size() - 1);
+        }
+        m_zoneIds = zoneIds;
+        m_populated = true;
+        if (!zoneIds.isEmpty()) {
+            endInsertRows();
+        }
+    }
+
+    void setZoneIds(const QList<QByteArray> &zoneIds)
+    {
+        beginResetModel();
+        m_zoneIds = zoneIds;
+        m_hasCustomZoneIds = true;
+        endResetModel();
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        if (parent.isValid()) {
+            return 0;
+        }
+        return FixedRowCount + (m_populated ? m_zoneIds.size() : 0);
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+            return QVariant();
+        }
+
+        const int row = index.row();
+        switch (role) {
+        case Qt::DisplayRole:
+            if (row == 0) {
+                return KDateTimeEdit::tr("UTC", "@item:inlistbox UTC time zone");
+            } else if (row == 1) {
+                return KDateTimeEdit::tr("Floating", "@item:inlistbox No specific time zone");
+            }
+            return QString::fromUtf8(m_zoneIds.at(row - FixedRowCount));
+        case Qt::UserRole:
+            if (row == 0) {
+                return QByteArray("UTC");
+            } else if (row == 1) {
+                return QByteArray();
+            }
+            return m_zoneIds.at(row - FixedRowCount);
+        }
+        return QVariant();
+    }
+
+private:
+    enum {
+        FixedRowCount = 2,
+    };
+
+    QList<QByteArray> m_zoneIds;
+    bool m_hasCustomZoneIds = false;
+    bool m_populated = false;
+};
+
 class KDateTimeEditPrivate
 {
 public:
@@ -47,7 +148,11 @@ public:
     QString m_maxWarnMsg;
 
     QList<QLocale> m_calendarLocales;
+    // Only used once setTimeZones() has been called, otherwise the shared
+    // systemTimeZones() are used
     QList<QTimeZone> m_zones;
+    bool m_hasCustomZones = false;
+    KDateTimeEditTimeZoneModel *m_timeZoneModel = nullptr;
 
     Ui::KDateTimeEdit ui;
 };
@@ -60,11 +165,6 @@ KDateTimeEditPrivate::KDateTimeEditPrivate(KDateTimeEdit *qq)
     m_dateTime = QDateTime::currentDateTime();
     m_dateTime.setTime(QTime(0, 0, 0));
     m_calendarLocales << q->locale();
-    const auto zoneIds = QTimeZone::availableTimeZoneIds();
-    m_zones.reserve(zoneIds.size());
-    for (const QByteArray &zoneId : zoneIds) {
-        m_zones << QTimeZone(zoneId);
-    }
 }
 
 KDateTimeEditPrivate::~KDateTimeEditPrivate()
@@ -167,11 +267,9 @@ void KDateTimeEditPrivate::enterCalendar(const QLocale &calendarLocale)
 void KDateTimeEditPrivate::initTimeZoneWidget()
 {
     ui.m_timeZoneCombo->blockSignals(true);
-    ui.m_timeZoneCombo->clear();
-    ui.m_timeZoneCombo->addItem(KDateTimeEdit::tr("UTC", "@item:inlistbox UTC time zone"), QByteArray("UTC"));
-    ui.m_timeZoneCombo->addItem(KDateTimeEdit::tr("Floating", "@item:inlistbox No specific time zone"), QByteArray());
-    for (const QTimeZone &zone : std::as_const(m_zones)) {
-        ui.m_timeZoneCombo->addItem(QString::fromUtf8(zone.id()), zone.id());
+    if (!m_timeZoneModel) {
+        m_timeZoneModel = new KDateTimeEditTimeZoneModel(q);
+        ui.m_timeZoneCombo->setModel(m_timeZoneModel);
     }
     ui.m_timeZoneCombo->setVisible((m_options & KDateTimeEdit::ShowTimeZone) == KDateTimeEdit::ShowTimeZone);
     ui.m_timeZoneCombo->setEnabled((m_options & KDateTimeEdit::SelectTimeZone) == KDateTimeEdit::SelectTimeZone);
@@ -187,7 +285,7 @@ void KDateTimeEditPrivate::updateTimeZoneWidget()
 
 void KDateTimeEditPrivate::selectTimeZone(int index)
 {
-    enterTimeZone(ui.m_timeCombo->itemData(index).toByteArray());
+    enterTimeZone(ui.m_timeZoneCombo->itemData(index).toByteArray());
 }
 
 void KDateTimeEditPrivate::enterTimeZone(const QByteArray &zoneId)
@@ -494,19 +592,41 @@ QList<QTime> KDateTimeEdit::timeList() const
 
 void KDateTimeEdit::setTimeZones(const QList<QTimeZone> &zones)
 {
-    if (zones != d->m_zones) {
-        d->m_zones = zones;
-        d->updateTimeZoneWidget();
+    if (d->m_hasCustomZones && zones == d->m_zones) {
+        return;
+    }
+
+    d->m_zones = zones;
+    d->m_hasCustomZones = true;
+
+    QList<QByteArray> zoneIds;
+    zoneIds.reserve(zones.size());
+    for (const QTimeZone &zone : zones) {
+        zoneIds << zone.id();
     }
+    d->m_timeZoneModel->setZoneIds(zoneIds);
+    d->updateTimeZoneWidget();
 }
 
 QList<QTimeZone> KDateTimeEdit::timeZones() const
 {
-    return d->m_zones;
+    return d->m_hasCustomZones ? d->m_zones : systemTimeZones();
 }
 
 bool KDateTimeEdit::eventFilter(QObject *object, QEvent *event)
 {
+    if (object == d->ui.m_timeZoneCombo) {
+        switch (event->type()) {
+        case QEvent::MouseButtonPress:
+        case QEvent::KeyPress:
+        case QEvent::Wheel:
+            // About to open the popup or to change the selection
+            d->m_timeZoneModel->populate();
+            break;
+        default:
+            break;
+        }
+    }
     return QWidget::eventFilter(object, event);
 }
 
@@ -8,6 +8,8 @@
 
 #include "kfontchooser.h"
 #include "fonthelpers_p.h"
+#include "kfontfamilypreview_p.h"
+#include "ktracing_p.h"
 #include "ui_kfontchooserwidget.h"
 
 #include "loggingcategory.h"
@@ -101,6 +103,10 @@ public:
 
     std::unique_ptr<Ui_KFontChooserWidget> m_ui;
 
+    // set while the families are shown in their own fonts
+    KFontFamilyPreviewDelegate *m_previewDelegate = nullptr;
+    QAbstractItemDelegate *m_defaultFamilyDelegate = nullptr;
+
     KFontChooser::DisplayFlags m_flags = KFontChooser::NoDisplayFlags;
 
     QPalette m_palette;
@@ -141,6 +147,7 @@ KFontChooser::~KFontChooser() = default;
 
 void KFontChooserPrivate::init()
 {
+    KTRACE_SCOPE("KFontChooser::init");
     m_usingFixed = m_flags & KFontChooser::FixedFontsOnly;
 
     // The main layout is divided horizontally into a top part with
@@ -304,6 +311,35 @@ void KFontChooser::setSampleBoxVisible(bool visible)
     d->m_ui->sampleTextEdit->setVisible(visible);
 }
 
+void KFontChooser::setFamilyPreviewEnabled(bool enabled)
+{
+    if (enabled == isFamilyPreviewEnabled()) {
+        return;
+    }
+
+    QListWidget *familyList = d->m_ui->familyListWidget;
+    if (enabled) {
+        d->m_defaultFamilyDelegate = familyList->itemDelegate();
+        d->m_previewDelegate = new KFontFamilyPreviewDelegate(
+            [this](const QString &text) {
+                const auto it = d->m_qtFamilies.find(text);
+                return it != d->m_qtFamilies.cend() ? it->second : text;
+            },
+            familyList);
+        familyList->setItemDelegate(d->m_previewDelegate);
+    } else {
+        familyList->setItemDelegate(d->m_defaultFamilyDelegate);
+        delete d->m_previewDelegate;
+        d->m_previewDelegate = nullptr;
+    }
+    familyList->viewport()->update();
+}
+
+bool KFontChooser::isFamilyPreviewEnabled() const
+{
+    return d->m_previewDelegate;
+}
+
 QSize KFontChooser::sizeHint(void) const
 {
     return minimumSizeHint();
@@ -375,6 +411,7 @@ static bool isDefaultFontStyleName(const QString &style)
 
 void KFontChooserPrivate::slotFamilySelected(const QString &family)
 {
+    KTRACE_SCOPE("KFontChooser::slotFamilySelected");
     if (!m_signalsAllowed) {
         return;
     }
@@ -813,6 +850,7 @@ void KFontChooser::setFontListItems(const QStringList &fontList)
 
 void KFontChooserPrivate::setFamilyBoxItems(const QStringList &fonts)
 {
+    KTRACE_SCOPE("KFontChooser::setFamilyBoxItems");
     m_signalsAllowed = false;
 
     m_ui->familyListWidget->clear();
@@ -846,6 +884,7 @@ void KFontChooserPrivate::setFamilyBoxItems(const QStringList &fonts)
         list.push_back(name);
     }
 
+    KTRACE_COUNTER("KFontChooser families", list.size());
     m_ui->familyListWidget->addItems(list);
     m_ui->familyListWidget->setMinimumWidth(minimumListWidth(m_ui->familyListWidget));
 
@@ -189,6 +189,27 @@ public:
      */
     void setSampleBoxVisible(bool visible);
 
+    /**
+     * If @p enabled is @c true, each family in the family list is shown in its own font.
+     *
+     * The previews are rendered in the background, so the list stays responsive
+     * even with thousands of fonts. Until the preview of a family is ready, its
+     * name is shown in the normal font.
+     *
+     * The default is @c false.
+     *
+     * @since 6.0
+     */
+    void setFamilyPreviewEnabled(bool enabled);
+
+    /**
+     * Returns whether each family in the family list is shown in its own font.
+     *
+     * @see setFamilyPreviewEnabled()
+     * @since 6.0
+     */
+    bool isFamilyPreviewEnabled() const;
+
     /**
      * The selection criteria for the font families shown in the dialog.
      */
@@ -0,0 +1,187 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kfontfamilypreview_p.h"
+#include "ktracing_p.h"
+
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QFontDatabase>
+#include <QFontInfo>
+#include <QFontMetricsF>
+#include <QPainter>
+#include <QRunnable>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+
+// the cache cost is the size of a preview in KiB
+static constexpr int MaxCachedPreviewKiB = 8 * 1024;
+static constexpr int MaxCachedTintedPreviewKiB = 4 * 1024;
+// the widest preview in device independent pixels, longer family names are cut off
+static constexpr int MaxPreviewWidth = 512;
+// when scrolling quickly through the list, the requests of rows that have already
+// been scrolled away are dropped once there are more than this
+static constexpr int MaxPendingPreviews = 128;
+
+size_t qHash(const KFontFamilyPreviewDelegate::Key &key, size_t seed)
+{
+    return qHashMulti(seed, key.family, key.pixelSize, key.devicePixelRatio);
+}
+
+size_t qHash(const KFontFamilyPreviewDelegate::TintedKey &key, size_t seed)
+{
+    return qHashMulti(seed, key.key, key.color);
+}
+
+static qsizetype costInKiB(const QImage &image)
+{
+    return std::max<qsizetype>(1, image.sizeInBytes() / 1024);
+}
+
+// renders text in black, the color is applied when painting
+static QImage renderPreview(const KFontFamilyPreviewDelegate::Key &key, const QString &text)
+{
+    KTRACE_SCOPE("KFontFamilyPreviewDelegate::renderPreview");
+    QFont font(key.family);
+    font.setPixelSize(key.pixelSize);
+    const QFontMetricsF metrics(font);
+    const QSizeF size(std::clamp(metrics.horizontalAdvance(text), 1.0, qreal(MaxPreviewWidth)), std::max(metrics.height(), 1.0));
+
+    QImage preview((size * key.devicePixelRatio).toSize(), QImage::Format_ARGB32_Premultiplied);
+    preview.setDevicePixelRatio(key.devicePixelRatio);
+    preview.fill(Qt::transparent);
+
+    QPainter painter(&preview);
+    painter.setFont(font);
+    painter.setPen(Qt::black);
+    painter.drawText(QRectF(QPointF(0, 0), size), Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine, text);
+    return preview;
+}
+
+static QImage tintPreview(const QImage &preview, const QColor &color)
+{
+    QImage tinted(preview.size(), QImage::Format_ARGB32_Premultiplied);
+    tinted.setDevicePixelRatio(preview.devicePixelRatio());
+    tinted.fill(Qt::transparent);
+
+    QPainter painter(&tinted);
+    painter.drawImage(0, 0, preview);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    painter.fillRect(tinted.rect(), color);
+    return tinted;
+}
+
+KFontFamilyPreviewDelegate::KFontFamilyPreviewDelegate(std::function<QString(const QString &)> familyForText, QAbstractItemView *view)
+    : QStyledItemDelegate(view)
+    , m_familyForText(std::move(familyForText))
+    , m_view(view)
+    , m_previews(MaxCachedPreviewKiB)
+    , m_tintedPreviews(MaxCachedTintedPreviewKiB)
+{
+    // leave the other cores to the GUI thread and everything else
+    m_renderPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+}
+
+KFontFamilyPreviewDelegate::~KFontFamilyPreviewDelegate()
+{
+    // results of running renderings are delivered through queued calls,
+    // which are discarded together with this object
+    m_renderPool.clear();
+    m_renderPool.waitForDone();
+}
+
+void KFontFamilyPreviewDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+
+    const Key key{m_familyForText(opt.text), QFontInfo(opt.font).pixelSize(), painter->device()->devicePixelRatioF()};
+    const QImage *preview = m_previews.object(key);
+    if (!preview) {
+        requestPreview(key, opt.text);
+        // the placeholder is the usual item
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    const QWidget *widget = opt.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    const QRect textRect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, widget);
+
+    // the item without its text, with the preview in its place
+    opt.text.clear();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    const QPalette::ColorGroup colorGroup = !(opt.state & QStyle::State_Enabled) ? QPalette::Disabled
+        : (opt.state & QStyle::State_Active)                                    ? QPalette::Normal
+                                                                                : QPalette::Inactive;
+    const QColor color = opt.palette.color(colorGroup, opt.state & QStyle::State_Selected ? QPalette::HighlightedText : QPalette::Text);
+
+    const TintedKey tintedKey{key, color.rgba()};
+    QImage tinted;
+    if (const QImage *cached = m_tintedPreviews.object(tintedKey)) {
+        tinted = *cached;
+    } else {
+        tinted = tintPreview(*preview, color);
+        m_tintedPreviews.insert(tintedKey, new QImage(tinted), costInKiB(tinted));
+    }
+
+    const QSizeF previewSize = preview->deviceIndependentSize();
+    const QPointF topLeft(textRect.left(), textRect.top() + (textRect.height() - previewSize.height()) / 2);
+    painter->save();
+    painter->setClipRect(textRect);
+    painter->drawImage(topLeft, tinted);
+    painter->restore();
+}
+
+void KFontFamilyPreviewDelegate::requestPreview(const Key &key, const QString &text) const
+{
+    if (m_pendingPreviews.contains(key)) {
+        return;
+    }
+    if (m_pendingPreviews.size() >= MaxPendingPreviews) {
+        // renderings that have already started still arrive, the others are requested again when painted
+        m_renderPool.clear();
+        m_pendingPreviews.clear();
+    }
+    m_pendingPreviews.insert(key);
+    KTRACE_COUNTER("KFontFamilyPreviewDelegate pending previews", m_pendingPreviews.size());
+
+    auto *self = const_cast<KFontFamilyPreviewDelegate *>(this);
+    if (!QFontDatabase::supportsThreadedFontRendering()) {
+        // render on the GUI thread, but still after the visible rows got their placeholders
+        QTimer::singleShot(0, self, [self, key, text]() {
+            if (self->m_pendingPreviews.contains(key)) {
+                self->addPreview(key, renderPreview(key, text));
+            }
+        });
+        return;
+    }
+
+    // the most recently requested rows are the visible ones, render them first
+    m_renderPool.start(QRunnable::create([self, key, text]() {
+                           const QImage preview = renderPreview(key, text);
+                           QMetaObject::invokeMethod(
+                               self,
+                               [self, key, preview]() {
+                                   self->addPreview(key, preview);
+                               },
+                               Qt::QueuedConnection);
+                       }),
+                       ++m_requestCount);
+}
+
+void KFontFamilyPreviewDelegate::addPreview(const Key &key, const QImage &preview)
+{
+    m_pendingPreviews.remove(key);
+    m_previews.insert(key, new QImage(preview), costInKiB(preview));
+    m_view->viewport()->update();
+}
+
+#include "moc_kfontfamilypreview_p.cpp"
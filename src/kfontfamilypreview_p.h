@@ -0,0 +1,85 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KFONTFAMILYPREVIEW_P_H
+#define KFONTFAMILYPREVIEW_P_H
+
+#include <QCache>
+#include <QImage>
+#include <QSet>
+#include <QStyledItemDelegate>
+#include <QThreadPool>
+
+#include <functional>
+
+/**
+ * @internal
+ *
+ * Item delegate for the family list of KFontChooser, which shows every family
+ * in its own font.
+ *
+ * Loading and shaping a font is too slow to do for every visible row while
+ * scrolling, so the previews are rendered into images in the background and
+ * kept in a bounded cache, as are their copies in the text colors of the
+ * rows. Until the preview of a row is ready, the row is painted as usual,
+ * with the family name in the font of the list.
+ */
+class KFontFamilyPreviewDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param familyForText maps the text of an item to the family known to QFontDatabase
+     * @param view the view the delegate is used in, it gets repainted when previews arrive
+     */
+    KFontFamilyPreviewDelegate(std::function<QString(const QString &)> familyForText, QAbstractItemView *view);
+    ~KFontFamilyPreviewDelegate() override;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    struct Key {
+        QString family;
+        int pixelSize;
+        qreal devicePixelRatio;
+
+        bool operator==(const Key &other) const
+        {
+            return family == other.family && pixelSize == other.pixelSize && devicePixelRatio == other.devicePixelRatio;
+        }
+    };
+
+    // a preview in the text color of a row, usually there are only the normal and the selected one
+    struct TintedKey {
+        Key key;
+        QRgb color;
+
+        bool operator==(const TintedKey &other) const
+        {
+            return key == other.key && color == other.color;
+        }
+    };
+
+private:
+    void requestPreview(const Key &key, const QString &text) const;
+    void addPreview(const Key &key, const QImage &preview);
+
+    std::function<QString(const QString &)> m_familyForText;
+    QAbstractItemView *const m_view;
+
+    // the previews are requested while painting, hence mutable
+    mutable QCache<Key, QImage> m_previews;
+    mutable QCache<TintedKey, QImage> m_tintedPreviews;
+    mutable QSet<Key> m_pendingPreviews;
+    mutable QThreadPool m_renderPool;
+    mutable int m_requestCount = 0;
+};
+
+size_t qHash(const KFontFamilyPreviewDelegate::Key &key, size_t seed = 0);
+size_t qHash(const KFontFamilyPreviewDelegate::TintedKey &key, size_t seed = 0);
+
+#endif
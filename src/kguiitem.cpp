@@ -10,6 +10,8 @@
 
 #include "kguiitem.h"
 
+#include "common_helpers_p.h"
+
 #include <QPushButton>
 #include <QSharedData>
 
@@ -72,30 +74,7 @@ QString KGuiItem::text() const
 
 QString KGuiItem::plainText() const
 {
-    const int len = d->m_text.length();
-
-    if (len == 0) {
-        return d->m_text;
-    }
-
-    // Can assume len >= 1 from now on.
-    QString stripped;
-
-    int resultLength = 0;
-    stripped.resize(len);
-
-    const QChar *data = d->m_text.unicode();
-    for (int pos = 0; pos < len; ++pos) {
-        if (data[pos] != QLatin1Char('&')) {
-            stripped[resultLength++] = data[pos];
-        } else if (pos + 1 < len && data[pos + 1] == QLatin1Char('&')) {
-            stripped[resultLength++] = data[pos++];
-        }
-    }
-
-    stripped.truncate(resultLength);
-
-    return stripped;
+    return stripAcceleratorMarkers(d->m_text, AcceleratorKind::AnyCharacter);
 }
 
 QIcon KGuiItem::icon() const
@@ -8,20 +8,26 @@
 
 #include "kmessagebox.h"
 #include "kmessagebox_p.h"
+#include "ktracing_p.h"
 
 #include <QCheckBox>
 #include <QDialog>
 #include <QLabel>
 #include <QLayout>
-#include <QListWidget>
+#include <QListView>
 #include <QPointer>
 #include <QPushButton>
 #include <QScreen>
 #include <QScrollArea>
 #include <QScrollBar>
+#include <QStringListModel>
 #include <QTextBrowser>
 #include <QWindow>
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+
 #include <qapplication.h>
 #if 0
 // NOTE waiting for the notification framework plan
@@ -88,6 +94,43 @@ static QDialog *createWIdDialog(WId parent_id)
     return dialog;
 }
 
+/**
+ * @private Prevent kapidox's doxygen config pick up this namespace method
+ * Returns the width needed to show the strings of @p strlist.
+ * Only a bounded number of strings is measured, the first ones and the ones
+ * with the most characters, so that huge lists don't delay showing the dialog.
+ */
+static int stringListWidth(const QFontMetrics &fm, const QStringList &strlist)
+{
+    constexpr qsizetype sampleCount = 100;
+    constexpr size_t longestCount = 20;
+
+    int width = 0;
+    const qsizetype count = strlist.size();
+    for (qsizetype i = 0; i < std::min(count, sampleCount); ++i) {
+        width = std::max(width, fm.boundingRect(strlist.at(i)).width());
+    }
+
+    // min-heap of (length, index), keeping the longest strings among the remaining ones
+    using Candidate = std::pair<qsizetype, qsizetype>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> longest;
+    for (qsizetype i = sampleCount; i < count; ++i) {
+        const qsizetype length = strlist.at(i).size();
+        if (longest.size() < longestCount) {
+            longest.emplace(length, i);
+        } else if (length > longest.top().first) {
+            longest.pop();
+            longest.emplace(length, i);
+        }
+    }
+    while (!longest.empty()) {
+        width = std::max(width, fm.boundingRect(strlist.at(longest.top().second)).width());
+        longest.pop();
+    }
+
+    return width;
+}
+
 class DialogButtonsHelper : public QObject
 {
     Q_OBJECT
@@ -164,6 +207,9 @@ QDialogButtonBox::StandardButton createKMessageBox(QDialog *dialog,
                                                    const QString &details,
                                                    QMessageBox::Icon notifyType)
 {
+    // only the construction, not the time the dialog is shown
+    KTRACE_BEGIN("KMessageBox::createKMessageBox");
+
     if (!isNotifyInterfaceLoaded()) {
         // This is annoying. Loading the interface later (or at any point) will
         // install the qm translation of the knotifications library which will cause a LanguageChange event to be sent
@@ -172,6 +218,7 @@ QDialogButtonBox::StandardButton createKMessageBox(QDialog *dialog,
         // For people wondering if they can remove this bit of code later, this seems to only be an issue
         // in non Plasma desktops, emulate by running something like XDG_CURRENT_DESKTOP=X-Cinnamon okular
         // on plasma desktops the platform plugin already uses knotifications so it's qm has been loaded on startup
+        // Applications can avoid this slow path altogether by calling preloadInterfaces() on startup
         QMap<QPointer<QAbstractButton>, QString> buttonTexts;
         for (QAbstractButton *b : buttons->buttons()) {
             buttonTexts[b] = b->text();
@@ -261,25 +308,26 @@ QDialogButtonBox::StandardButton createKMessageBox(QDialog *dialog,
     if (usingListWidget) {
         // enable automatic wrapping since the listwidget has already a good initial width
         messageLabel->setWordWrap(true);
-        QListWidget *listWidget = new QListWidget(mainWidget);
-        listWidget->addItems(strlist);
+        // A plain string list model shares the list instead of creating one item per entry,
+        // and uniform item sizes spare the view from measuring every row
+        QListView *listView = new QListView(mainWidget);
+        listView->setModel(new QStringListModel(strlist, listView));
+        listView->setUniformItemSizes(true);
+        listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
 
         QStyleOptionViewItem styleOption;
-        styleOption.initFrom(listWidget);
+        styleOption.initFrom(listView);
         QFontMetrics fm(styleOption.font);
-        int w = listWidget->width();
-        for (const QString &str : strlist) {
-            w = qMax(w, fm.boundingRect(str).width());
-        }
-        const int borderWidth = listWidget->width() - listWidget->viewport()->width() + listWidget->verticalScrollBar()->height();
+        int w = qMax(listView->width(), stringListWidth(fm, strlist));
+        const int borderWidth = listView->width() - listView->viewport()->width() + listView->verticalScrollBar()->height();
         w += borderWidth;
-        if (w > desktop.width() * 0.85) { // limit listWidget size to 85% of screen width
+        if (w > desktop.width() * 0.85) { // limit listView size to 85% of screen width
             w = qRound(desktop.width() * 0.85);
         }
-        listWidget->setMinimumWidth(w);
+        listView->setMinimumWidth(w);
 
-        mainLayout->addWidget(listWidget, usingScrollArea ? 10 : 50);
-        listWidget->setSelectionMode(QListWidget::NoSelection);
+        mainLayout->addWidget(listView, usingScrollArea ? 10 : 50);
+        listView->setSelectionMode(QAbstractItemView::NoSelection);
         messageLabel->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Minimum);
     } else if (!usingScrollArea) {
         mainLayout->addStretch(15);
@@ -359,6 +407,8 @@ QDialogButtonBox::StandardButton createKMessageBox(QDialog *dialog,
     }
 #endif
 
+    KTRACE_END("KMessageBox::createKMessageBox");
+
     if (KMessageBox_exec_hook) {
         return KMessageBox_exec_hook(dialog);
     }
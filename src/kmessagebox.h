@@ -730,6 +730,23 @@ KWIDGETSADDONS_EXPORT void setDontShowAgainInterface(KMessageBoxDontAskAgainInte
  */
 KWIDGETSADDONS_EXPORT void setNotifyInterface(KMessageBoxNotifyInterface *notifyInterface);
 
+/**
+ * Loads the notification and dontShowAgain interfaces on the next pass of the
+ * event loop of the application, instead of when the first message box is shown.
+ * This is not deferred until the application is idle, the loading blocks the
+ * event loop like any other event handler.
+ *
+ * Loading them may install translations, which the first message box then has
+ * to wait for; calling this at the end of the application startup lets message
+ * boxes be shown right away. Message boxes created before the interfaces are
+ * loaded still take the slow path. Interfaces already set with setNotifyInterface()
+ * or setDontShowAgainInterface() should be set before calling this method.
+ * A QApplication instance must exist.
+ *
+ * @since 6.0
+ */
+KWIDGETSADDONS_EXPORT void preloadInterfaces();
+
 /**
  * Create content and layout of a standard dialog
  *
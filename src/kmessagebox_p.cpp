@@ -13,6 +13,7 @@
 #include <QPluginLoader>
 #include <QSettings>
 #include <QStandardPaths>
+#include <QTimer>
 
 namespace KMessageBox
 {
@@ -101,8 +102,13 @@ static void loadKMessageBoxPlugin()
         QPluginLoader lib(QStringLiteral("kf6/FrameworkIntegrationPlugin"));
         QObject *rootObj = lib.instance();
         if (rootObj) {
-            s_dontAskAgainInterface = rootObj->property(KMESSAGEBOXDONTASKAGAIN_PROPERTY).value<KMessageBoxDontAskAgainInterface *>();
-            s_notifyInterface = rootObj->property(KMESSAGEBOXNOTIFY_PROPERTY).value<KMessageBoxNotifyInterface *>();
+            // Don't override interfaces set by the application
+            if (!s_dontAskAgainInterface) {
+                s_dontAskAgainInterface = rootObj->property(KMESSAGEBOXDONTASKAGAIN_PROPERTY).value<KMessageBoxDontAskAgainInterface *>();
+            }
+            if (!s_notifyInterface) {
+                s_notifyInterface = rootObj->property(KMESSAGEBOXNOTIFY_PROPERTY).value<KMessageBoxNotifyInterface *>();
+            }
         }
     }
     if (!s_dontAskAgainInterface) {
@@ -134,6 +140,13 @@ bool isNotifyInterfaceLoaded()
     return s_notifyInterface;
 }
 
+void preloadInterfaces()
+{
+    QTimer::singleShot(0, QCoreApplication::instance(), []() {
+        loadKMessageBoxPlugin();
+    });
+}
+
 void setDontShowAgainInterface(KMessageBoxDontAskAgainInterface *dontAskAgainInterface)
 {
     Q_ASSERT(dontAskAgainInterface != nullptr);
@@ -7,6 +7,7 @@
     SPDX-License-Identifier: LGPL-2.1-or-later
 */
 #include "kmessagewidget.h"
+#include "ktracing_p.h"
 
 #include <QAction>
 #include <QApplication>
@@ -197,6 +198,7 @@ void KMessageWidgetPrivate::updateLayout()
 
 void KMessageWidgetPrivate::slotTimeLineChanged(qreal value)
 {
+    KTRACE_COUNT("KMessageWidget animation ticks");
     q->setFixedHeight(qMin(value * 2, qreal(1.0)) * bestContentHeight());
     q->update();
 }
@@ -10,6 +10,7 @@
 #include "kpageview_p.h"
 
 #include "kpagemodel.h"
+#include "ktracing_p.h"
 #include "loggingcategory.h"
 
 #include <ktitlewidget.h>
@@ -21,6 +22,7 @@
 
 void KPageViewPrivate::rebuildGui()
 {
+    KTRACE_SCOPE("KPageView::rebuildGui");
     // clean up old view
     Q_Q(KPageView);
 
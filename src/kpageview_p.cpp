@@ -9,6 +9,7 @@
 #include "kpageview_p.h"
 
 #include <QApplication>
+#include <QHash>
 #include <QHeaderView>
 #include <QPainter>
 #include <QScrollBar>
@@ -92,6 +93,7 @@ KPageListView::~KPageListView()
 void KPageListView::setModel(QAbstractItemModel *model)
 {
     connect(model, &QAbstractItemModel::layoutChanged, this, &KPageListView::updateWidth);
+    connect(model, &QAbstractItemModel::dataChanged, this, &KPageListView::updateWidth);
 
     QListView::setModel(model);
 
@@ -135,6 +137,17 @@ void KPageTreeView::setModel(QAbstractItemModel *model)
     // Set our own selection model, which won't allow our current selection to be cleared
     setSelectionModel(new KDEPrivate::SelectionModel(model, this));
 
+    // Only newly inserted pages need to be expanded, the ones already shown keep their state
+    connect(model, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex &parent, int first, int last) {
+        if (parent.isValid()) {
+            setExpanded(parent, true);
+        }
+        for (int row = first; row <= last; ++row) {
+            expandItems(this->model()->index(row, 0, parent));
+        }
+    });
+
+    expandAll();
     updateWidth();
 }
 
@@ -146,12 +159,13 @@ void KPageTreeView::updateWidth()
 
     int columns = model()->columnCount();
 
-    expandItems();
-
     int width = 0;
     for (int i = 0; i < columns; ++i) {
-        resizeColumnToContents(i);
-        width = qMax(width, sizeHintForColumn(i));
+        // The header is hidden, so this is what resizeColumnToContents() would do,
+        // without computing the size hints of all the items a second time
+        const int columnWidth = sizeHintForColumn(i);
+        setColumnWidth(i, columnWidth);
+        width = qMax(width, columnWidth);
     }
 
     setFixedWidth(width + 25);
@@ -159,9 +173,12 @@ void KPageTreeView::updateWidth()
 
 void KPageTreeView::expandItems(const QModelIndex &index)
 {
-    setExpanded(index, true);
-
     const int count = model()->rowCount(index);
+    if (count == 0) {
+        return;
+    }
+
+    setExpanded(index, true);
     for (int i = 0; i < count; ++i) {
         expandItems(model()->index(i, 0, index));
     }
@@ -207,11 +224,30 @@ void KPageTabbedView::setModel(QAbstractItemModel *model)
 {
     QAbstractItemView::setModel(model);
 
+    mLayoutChanging = false;
+    connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this, [this]() {
+        mLayoutChanging = true;
+    });
     connect(model, &QAbstractItemModel::layoutChanged, this, &KPageTabbedView::layoutChanged);
+    connect(model, &QAbstractItemModel::modelReset, this, &KPageTabbedView::layoutChanged);
+    connect(model, &QAbstractItemModel::rowsInserted, this, &KPageTabbedView::rowsChanged);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &KPageTabbedView::rowsChanged);
+    connect(model, &QAbstractItemModel::rowsMoved, this, [this](const QModelIndex &sourceParent, int, int, const QModelIndex &destinationParent) {
+        rowsChanged(sourceParent.isValid() ? destinationParent : sourceParent);
+    });
 
     layoutChanged();
 }
 
+void KPageTabbedView::rowsChanged(const QModelIndex &parent)
+{
+    // KPageWidgetModel wraps every insertion and removal in a layout change,
+    // the tabs are synchronized once that is done
+    if (!parent.isValid() && !mLayoutChanging) {
+        layoutChanged();
+    }
+}
+
 QModelIndex KPageTabbedView::indexAt(const QPoint &) const
 {
     if (model()) {
@@ -280,36 +316,86 @@ void KPageTabbedView::currentPageChanged(int index)
     selectionModel()->setCurrentIndex(modelIndex, QItemSelectionModel::ClearAndSelect);
 }
 
-void KPageTabbedView::layoutChanged()
+static QWidget *pageOfTab(QWidget *wrapper)
 {
-    // save old position
-    int pos = mTabWidget->currentIndex();
+    // the layout forgets about the page if it got deleted
+    QLayoutItem *item = wrapper->layout()->itemAt(0);
+    return item ? item->widget() : nullptr;
+}
 
-    // clear tab bar
-    int count = mTabWidget->count();
-    for (int i = 0; i < count; ++i) {
-        mTabWidget->removeTab(0);
+void KPageTabbedView::layoutChanged()
+{
+    // Synchronizes the tabs with the top-level rows of the model. Pages that are
+    // already shown keep their wrapper widget and are at most moved, so that
+    // inserting or removing a single page neither reparents nor relayouts the others.
+    mLayoutChanging = false;
+    const int oldPos = mTabWidget->currentIndex();
+    QWidget *const oldCurrentWrapper = mTabWidget->currentWidget();
+
+    QHash<QWidget *, QWidget *> wrappers;
+    for (int i = 0; i < mTabWidget->count(); ++i) {
+        QWidget *wrapper = mTabWidget->widget(i);
+        if (QWidget *page = pageOfTab(wrapper)) {
+            wrappers.insert(page, wrapper);
+        }
     }
 
-    if (!model()) {
-        return;
-    }
+    {
+        const QSignalBlocker blocker(mTabWidget);
+
+        int tab = 0;
+        const int rowCount = model() ? model()->rowCount() : 0;
+        for (int i = 0; i < rowCount; ++i) {
+            const QModelIndex index = model()->index(i, 0);
+            QWidget *page = qvariant_cast<QWidget *>(model()->data(index, KPageModel::WidgetRole));
+            if (!page) {
+                continue;
+            }
+
+            const QString title = model()->data(index).toString();
+            const QIcon icon = model()->data(index, Qt::DecorationRole).value<QIcon>();
 
-    // add new tabs
-    for (int i = 0; i < model()->rowCount(); ++i) {
-        const QString title = model()->data(model()->index(i, 0)).toString();
-        const QIcon icon = model()->data(model()->index(i, 0), Qt::DecorationRole).value<QIcon>();
-        QWidget *page = qvariant_cast<QWidget *>(model()->data(model()->index(i, 0), KPageModel::WidgetRole));
-        if (page) {
-            QWidget *widget = new QWidget(this);
-            QVBoxLayout *layout = new QVBoxLayout(widget);
-            layout->addWidget(page);
-            page->setVisible(true);
-            mTabWidget->addTab(widget, icon, title);
+            QWidget *wrapper = wrappers.take(page);
+            if (wrapper && mTabWidget->widget(tab) == wrapper) {
+                // the page may have changed without a dataChanged() for it
+                mTabWidget->setTabText(tab, title);
+                mTabWidget->setTabIcon(tab, icon);
+                ++tab;
+                continue;
+            }
+
+            if (wrapper) {
+                mTabWidget->removeTab(mTabWidget->indexOf(wrapper));
+            } else {
+                wrapper = new QWidget(this);
+                QVBoxLayout *layout = new QVBoxLayout(wrapper);
+                layout->addWidget(page);
+                page->setVisible(true);
+            }
+
+            mTabWidget->insertTab(tab, wrapper, icon, title);
+            ++tab;
+        }
+
+        // whatever is left behind no longer belongs to the model
+        while (mTabWidget->count() > tab) {
+            QWidget *wrapper = mTabWidget->widget(tab);
+            mTabWidget->removeTab(tab);
+            if (QWidget *page = pageOfTab(wrapper)) {
+                page->setVisible(false);
+                page->setParent(nullptr);
+            }
+            delete wrapper;
         }
+
+        // keep the current page if it is still there
+        const int currentPos = oldCurrentWrapper ? mTabWidget->indexOf(oldCurrentWrapper) : -1;
+        mTabWidget->setCurrentIndex(currentPos != -1 ? currentPos : qMin(oldPos, mTabWidget->count() - 1));
     }
 
-    mTabWidget->setCurrentIndex(pos);
+    if (mTabWidget->currentWidget() != oldCurrentWrapper || mTabWidget->currentIndex() != oldPos) {
+        currentPageChanged(mTabWidget->currentIndex());
+    }
 }
 
 void KPageTabbedView::dataChanged(const QModelIndex &index, const QModelIndex &, const QList<int> &roles)
@@ -357,6 +443,64 @@ static int layoutText(QTextLayout *layout, int maxWidth)
     return textWidth;
 }
 
+void KPageListViewDelegate::watchModel(const QAbstractItemModel *model) const
+{
+    if (mPaintCacheModel == model) {
+        return;
+    }
+
+    if (mPaintCacheModel) {
+        disconnect(mPaintCacheModel, nullptr, this, nullptr);
+    }
+    mPaintCache.clear();
+    mPaintCacheModel = model;
+
+    auto clearCache = [this]() {
+        mPaintCache.clear();
+    };
+    connect(model, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+            mPaintCache.remove(QPersistentModelIndex(topLeft.sibling(row, 0)));
+        }
+    });
+    connect(model, &QAbstractItemModel::layoutChanged, this, clearCache);
+    connect(model, &QAbstractItemModel::modelReset, this, clearCache);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, clearCache);
+}
+
+KPageListViewDelegate::PaintCacheEntry &
+KPageListViewDelegate::paintCacheEntry(const QStyleOptionViewItem &option, const QModelIndex &index, int iconSize, int lineHeight) const
+{
+    watchModel(index.model());
+
+    const QString text = index.model()->data(index, Qt::DisplayRole).toString();
+    const QIcon icon = index.model()->data(index, Qt::DecorationRole).value<QIcon>();
+    const qreal dpr = option.widget ? option.widget->devicePixelRatioF() : qApp->devicePixelRatio();
+
+    PaintCacheEntry &entry = mPaintCache[QPersistentModelIndex(index)];
+    if (entry.textLayout && entry.text == text && entry.iconKey == icon.cacheKey() && entry.font == option.font && entry.lineHeight == lineHeight
+        && entry.iconSize == iconSize && qFuzzyCompare(entry.devicePixelRatio, dpr) && (icon.isNull() || !entry.pixmaps[0].isNull())) {
+        return entry;
+    }
+
+    entry.text = text;
+    entry.iconKey = icon.cacheKey();
+    entry.font = option.font;
+    entry.lineHeight = lineHeight;
+    entry.iconSize = iconSize;
+    entry.devicePixelRatio = dpr;
+    entry.pixmaps[0] = icon.pixmap(QSize(iconSize, iconSize), dpr, QIcon::Normal);
+    entry.pixmaps[1] = QPixmap();
+
+    const int wp = entry.pixmaps[0].width() / entry.pixmaps[0].devicePixelRatio();
+    entry.maxTextWidth = qMax(3 * wp, 8 * lineHeight);
+    entry.textLayout = std::make_shared<QTextLayout>(text, option.font);
+    entry.textLayout->setTextOption(QTextOption(Qt::AlignHCenter));
+    layoutText(entry.textLayout.get(), entry.maxTextWidth);
+
+    return entry;
+}
+
 void KPageListViewDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
     if (!index.isValid()) {
@@ -369,20 +513,19 @@ void KPageListViewDelegate::paint(QPainter *painter, const QStyleOptionViewItem
 
     const QIcon::Mode iconMode = (option.state & QStyle::State_Selected) && (option.state & QStyle::State_Active) ? QIcon::Selected : QIcon::Normal;
     int iconSize = style->pixelMetric(QStyle::PM_IconViewIconSize);
-    const QString text = index.model()->data(index, Qt::DisplayRole).toString();
-    const QIcon icon = index.model()->data(index, Qt::DecorationRole).value<QIcon>();
-    const QPixmap pixmap = icon.pixmap(iconSize, iconSize, iconMode);
 
     QFontMetrics fm = painter->fontMetrics();
+    PaintCacheEntry &entry = paintCacheEntry(option, index, iconSize, fm.height());
+
+    QPixmap &pixmap = entry.pixmaps[iconMode == QIcon::Selected ? 1 : 0];
+    if (pixmap.isNull()) {
+        const QIcon icon = index.model()->data(index, Qt::DecorationRole).value<QIcon>();
+        pixmap = icon.pixmap(QSize(iconSize, iconSize), entry.devicePixelRatio, iconMode);
+    }
+
     int wp = pixmap.width() / pixmap.devicePixelRatio();
     int hp = pixmap.height() / pixmap.devicePixelRatio();
 
-    QTextLayout iconTextLayout(text, option.font);
-    QTextOption textOption(Qt::AlignHCenter);
-    iconTextLayout.setTextOption(textOption);
-    int maxWidth = qMax(3 * wp, 8 * fm.height());
-    layoutText(&iconTextLayout, maxWidth);
-
     QPen pen = painter->pen();
     QPalette::ColorGroup cg = option.state & QStyle::State_Enabled ? QPalette::Normal : QPalette::Disabled;
     if (cg == QPalette::Normal && !(option.state & QStyle::State_Active)) {
@@ -397,8 +540,8 @@ void KPageListViewDelegate::paint(QPainter *painter, const QStyleOptionViewItem
     }
 
     painter->drawPixmap(option.rect.x() + (option.rect.width() / 2) - (wp / 2), option.rect.y() + 5, pixmap);
-    if (!text.isEmpty()) {
-        iconTextLayout.draw(painter, QPoint(option.rect.x() + (option.rect.width() / 2) - (maxWidth / 2), option.rect.y() + hp + 7));
+    if (!entry.text.isEmpty()) {
+        entry.textLayout->draw(painter, QPoint(option.rect.x() + (option.rect.width() / 2) - (entry.maxTextWidth / 2), option.rect.y() + hp + 7));
     }
 
     painter->setPen(pen);
@@ -419,6 +562,15 @@ QSize KPageListViewDelegate::sizeHint(const QStyleOptionViewItem &option, const
     int iconSize = style->pixelMetric(QStyle::PM_IconViewIconSize);
     const QString text = index.model()->data(index, Qt::DisplayRole).toString();
     const QIcon icon = index.model()->data(index, Qt::DecorationRole).value<QIcon>();
+    const qreal dpr = opt.widget ? opt.widget->devicePixelRatioF() : qApp->devicePixelRatio();
+
+    const QString cacheKey = text + QLatin1Char('\x1f') + QString::number(icon.cacheKey()) + QLatin1Char('\x1f') + option.font.key() + QLatin1Char('\x1f')
+        + QString::number(iconSize) + QLatin1Char('\x1f') + QString::number(dpr);
+    const auto it = mSizeHintCache.constFind(cacheKey);
+    if (it != mSizeHintCache.constEnd()) {
+        return *it;
+    }
+
     const QPixmap pixmap = icon.pixmap(iconSize, iconSize);
 
     QFontMetrics fm = option.fontMetrics;
@@ -426,7 +578,8 @@ QSize KPageListViewDelegate::sizeHint(const QStyleOptionViewItem &option, const
     int wp = pixmap.width() / pixmap.devicePixelRatio();
     int hp = pixmap.height() / pixmap.devicePixelRatio();
 
-    if (hp == 0) {
+    const bool pixmapLoaded = hp != 0 || icon.isNull();
+    if (!pixmapLoaded) {
         // No pixmap loaded yet, we'll use the default icon size in this case.
         hp = iconSize;
         wp = iconSize;
@@ -446,7 +599,15 @@ QSize KPageListViewDelegate::sizeHint(const QStyleOptionViewItem &option, const
 
     width = qMax(wt, wp) + gap;
 
-    return QSize(width, height);
+    const QSize size(width, height);
+    if (pixmapLoaded) {
+        // Titles only change rarely, this just keeps stale entries from piling up
+        if (mSizeHintCache.size() > 1000) {
+            mSizeHintCache.clear();
+        }
+        mSizeHintCache.insert(cacheKey, size);
+    }
+    return size;
 }
 
 void KPageListViewDelegate::drawFocus(QPainter *painter, const QStyleOptionViewItem &option, const QRect &rect) const
@@ -14,12 +14,17 @@
 #include <QAbstractItemDelegate>
 #include <QAbstractProxyModel>
 #include <QGridLayout>
+#include <QHash>
 #include <QListView>
+#include <QPixmap>
 #include <QPointer>
 #include <QStackedWidget>
+#include <QTextLayout>
 #include <QTreeView>
 #include <ktitlewidget.h>
 
+#include <memory>
+
 class KPageStackedWidget : public QStackedWidget
 {
     Q_OBJECT
@@ -146,7 +151,7 @@ private Q_SLOTS:
     void updateWidth();
 
 private:
-    void expandItems(const QModelIndex &index = QModelIndex());
+    void expandItems(const QModelIndex &index);
 };
 
 class KPageTabbedView : public QAbstractItemView
@@ -179,7 +184,11 @@ private Q_SLOTS:
     void dataChanged(const QModelIndex &, const QModelIndex &, const QList<int> &roles) override;
 
 private:
+    void rowsChanged(const QModelIndex &parent);
+
     QTabWidget *mTabWidget;
+    // set between layoutAboutToBeChanged() and layoutChanged() of the model
+    bool mLayoutChanging = false;
 };
 
 class KPageListViewDelegate : public QAbstractItemDelegate
@@ -193,7 +202,30 @@ public:
     QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
 
 private:
+    // What paint() needs for an item, reused for repaints (e.g. on hover) as long as
+    // the item's text and icon, the font, icon size and device pixel ratio stay the same
+    struct PaintCacheEntry {
+        QString text;
+        qint64 iconKey = 0;
+        QFont font;
+        int lineHeight = 0;
+        int iconSize = 0;
+        qreal devicePixelRatio = 0;
+        QPixmap pixmaps[2]; // QIcon::Normal and QIcon::Selected, rendered on first use
+        std::shared_ptr<QTextLayout> textLayout;
+        int maxTextWidth = 0;
+    };
+
     void drawFocus(QPainter *, const QStyleOptionViewItem &, const QRect &) const;
+    PaintCacheEntry &paintCacheEntry(const QStyleOptionViewItem &option, const QModelIndex &index, int iconSize, int lineHeight) const;
+    void watchModel(const QAbstractItemModel *model) const;
+
+    // Size hints keyed by text, icon, font, icon size and device pixel ratio,
+    // so that recomputing the width of the navigation view only lays out new
+    // or changed items
+    mutable QHash<QString, QSize> mSizeHintCache;
+    mutable QHash<QPersistentModelIndex, PaintCacheEntry> mPaintCache;
+    mutable QPointer<const QAbstractItemModel> mPaintCacheModel;
 };
 
 /**
@@ -10,15 +10,42 @@
 #include <QApplication>
 #include <QColor>
 #include <QCursor>
+#include <QFutureWatcher>
 #include <QHBoxLayout>
 #include <QImage>
-#include <QLabel>
 #include <QMenu>
 #include <QMouseEvent>
+#include <QPaintEvent>
 #include <QPainter>
+#include <QPromise>
 #include <QRubberBand>
+#include <QThreadPool>
 #include <QVBoxLayout>
 
+#include <memory>
+
+class KPixmapRegionSelectorWidgetPrivate;
+
+/**
+ * Paints the dimmed image with the undimmed selection on top of it, without
+ * composing an intermediate pixmap for every selection change.
+ */
+class KPixmapRegionSelectorCanvas : public QWidget
+{
+public:
+    KPixmapRegionSelectorCanvas(KPixmapRegionSelectorWidgetPrivate *dd, QWidget *parent)
+        : QWidget(parent)
+        , d(dd)
+    {
+    }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    KPixmapRegionSelectorWidgetPrivate *const d;
+};
+
 class KPixmapRegionSelectorWidgetPrivate
 {
 public:
@@ -30,21 +57,36 @@ public:
     KPixmapRegionSelectorWidget *const q;
 
     /**
-     * Recalculates the pixmap that is shown based on the current selected area,
-     * the original image, etc.
+     * Schedules a repaint of the parts of the canvas affected by a change of the
+     * selected area, the original image, etc.
      */
     void updatePixmap();
 
     QRect calcSelectionRectangle(const QPoint &startPoint, const QPoint &endPoint);
 
+    /**
+     * Shows the source image scaled to @p size (in rotated coordinates). A cheap
+     * placeholder is shown right away, the preview itself is scaled and rotated
+     * in a worker thread.
+     */
+    void buildPreview(const QSize &size);
+    void applySmoothPreview();
+
+    QSize rotatedSourceSize() const;
+    QImage rotatedImage(const QImage &image) const;
+    QRect mapToSource(const QRect &rect) const;
+
     enum CursorState { None = 0, Resizing, Moving };
-    CursorState m_state;
+    CursorState m_state = None;
 
-    QPixmap m_unzoomedPixmap;
+    QImage m_sourceImage; // full resolution, never rotated
+    int m_rotation = 0; // clockwise quarter turns to apply to m_sourceImage
+    QPixmap m_unzoomedPixmap; // rotated m_sourceImage, the one set or created on demand
     QPixmap m_originalPixmap;
     QPixmap m_linedPixmap;
     QRect m_selectedRegion;
-    QLabel *m_label;
+    QRect m_paintedRegion; // selection as currently shown on the canvas
+    KPixmapRegionSelectorCanvas *m_canvas;
 
     QPoint m_tempFirstClick;
     double m_forcedAspectRatio;
@@ -53,8 +95,118 @@ public:
     double m_zoomFactor;
 
     QRubberBand *m_rubberBand;
+
+    QFutureWatcher<QImage> m_previewWatcher;
 };
 
+/**
+ * Maps @p rect in an image of size @p imageSize to the coordinates of that
+ * image once rotated clockwise by @p quarterTurns
+ */
+static QRect rotateRect(const QRect &rect, const QSize &imageSize, int quarterTurns)
+{
+    switch (quarterTurns) {
+    case 1:
+        return QRect(imageSize.height() - rect.y() - rect.height(), rect.x(), rect.height(), rect.width());
+    case 2:
+        return QRect(imageSize.width() - rect.x() - rect.width(), imageSize.height() - rect.y() - rect.height(), rect.width(), rect.height());
+    case 3:
+        return QRect(rect.y(), imageSize.width() - rect.x() - rect.width(), rect.height(), rect.width());
+    default:
+        return rect;
+    }
+}
+
+// longest side of the placeholder shown until the preview is ready
+static constexpr int PlaceholderSize = 256;
+
+static QImage rotateImage(const QImage &image, int quarterTurns)
+{
+    if (quarterTurns == 0) {
+        return image;
+    }
+    return image.transformed(QTransform().rotate(90.0 * quarterTurns));
+}
+
+QSize KPixmapRegionSelectorWidgetPrivate::rotatedSourceSize() const
+{
+    return (m_rotation % 2) ? m_sourceImage.size().transposed() : m_sourceImage.size();
+}
+
+QImage KPixmapRegionSelectorWidgetPrivate::rotatedImage(const QImage &image) const
+{
+    return rotateImage(image, m_rotation);
+}
+
+QRect KPixmapRegionSelectorWidgetPrivate::mapToSource(const QRect &rect) const
+{
+    return rotateRect(rect, rotatedSourceSize(), (4 - m_rotation) % 4);
+}
+
+void KPixmapRegionSelectorWidgetPrivate::buildPreview(const QSize &size)
+{
+    m_previewWatcher.cancel();
+
+    // The pixmap that was set, or that pixmap() created for the current rotation
+    if (size == rotatedSourceSize() && !m_unzoomedPixmap.isNull()) {
+        m_originalPixmap = m_unzoomedPixmap;
+        return;
+    }
+
+    // A blocky placeholder from a few pixels of the source is cheap enough to be
+    // created synchronously, so that the geometry of the widget is known when
+    // returning. The source itself may be large, it's only touched by the worker.
+    const QSize sourceSize = (m_rotation % 2) ? size.transposed() : size;
+    const QSize placeholderSize = sourceSize.scaled(PlaceholderSize, PlaceholderSize, Qt::KeepAspectRatio).boundedTo(sourceSize).expandedTo(QSize(1, 1));
+    const QImage placeholder = rotatedImage(m_sourceImage.scaled(placeholderSize, Qt::IgnoreAspectRatio, Qt::FastTransformation));
+    m_originalPixmap = QPixmap::fromImage(placeholder.scaled(size, Qt::IgnoreAspectRatio, Qt::FastTransformation));
+
+    auto promise = std::make_shared<QPromise<QImage>>();
+    m_previewWatcher.setFuture(promise->future());
+    QThreadPool::globalInstance()->start([promise, source = m_sourceImage, sourceSize, rotation = m_rotation]() {
+        promise->start();
+        if (!promise->isCanceled()) {
+            const QImage scaled = sourceSize == source.size() ? source : source.scaled(sourceSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            promise->addResult(rotateImage(scaled, rotation));
+        }
+        promise->finish();
+    });
+}
+
+void KPixmapRegionSelectorWidgetPrivate::applySmoothPreview()
+{
+    const QFuture<QImage> future = m_previewWatcher.future();
+    if (future.isCanceled() || future.resultCount() == 0) {
+        return;
+    }
+
+    // Rotating or zooming meanwhile started another preview, this one is outdated then
+    const QImage preview = future.result();
+    if (preview.size() != m_originalPixmap.size()) {
+        return;
+    }
+
+    m_originalPixmap = QPixmap::fromImage(preview);
+    m_linedPixmap = QPixmap();
+    updatePixmap();
+}
+
+void KPixmapRegionSelectorCanvas::paintEvent(QPaintEvent *event)
+{
+    if (d->m_linedPixmap.isNull()) {
+        return;
+    }
+
+    QPainter painter(this);
+    const QRect exposed = event->rect();
+    painter.drawPixmap(exposed, d->m_linedPixmap, exposed);
+
+    const QRect selection = d->m_selectedRegion.intersected(exposed);
+    if (!selection.isEmpty()) {
+        painter.drawPixmap(selection, d->m_originalPixmap, selection);
+    }
+}
+
 KPixmapRegionSelectorWidget::KPixmapRegionSelectorWidget(QWidget *parent)
     : QWidget(parent)
     , d(new KPixmapRegionSelectorWidgetPrivate(this))
@@ -66,11 +218,10 @@ KPixmapRegionSelectorWidget::KPixmapRegionSelectorWidget(QWidget *parent)
     hboxLayout->addItem(vboxLayout);
 
     vboxLayout->addStretch();
-    d->m_label = new QLabel(this);
-    d->m_label->setAttribute(Qt::WA_NoSystemBackground, true); // setBackgroundMode( Qt::NoBackground );
-    d->m_label->installEventFilter(this);
+    d->m_canvas = new KPixmapRegionSelectorCanvas(d.get(), this);
+    d->m_canvas->installEventFilter(this);
 
-    vboxLayout->addWidget(d->m_label);
+    vboxLayout->addWidget(d->m_canvas);
     vboxLayout->addStretch();
 
     hboxLayout->addStretch();
@@ -78,23 +229,37 @@ KPixmapRegionSelectorWidget::KPixmapRegionSelectorWidget(QWidget *parent)
     d->m_forcedAspectRatio = 0;
 
     d->m_zoomFactor = 1.0;
-    d->m_rubberBand = new QRubberBand(QRubberBand::Rectangle, d->m_label);
+    d->m_rubberBand = new QRubberBand(QRubberBand::Rectangle, d->m_canvas);
     d->m_rubberBand->hide();
+
+    connect(&d->m_previewWatcher, &QFutureWatcher<QImage>::finished, this, [this]() {
+        d->applySmoothPreview();
+    });
 }
 
-KPixmapRegionSelectorWidget::~KPixmapRegionSelectorWidget() = default;
+KPixmapRegionSelectorWidget::~KPixmapRegionSelectorWidget()
+{
+    d->m_previewWatcher.cancel();
+}
 
 QPixmap KPixmapRegionSelectorWidget::pixmap() const
 {
+    if (d->m_unzoomedPixmap.isNull() && !d->m_sourceImage.isNull()) {
+        d->m_unzoomedPixmap = QPixmap::fromImage(d->rotatedImage(d->m_sourceImage));
+    }
     return d->m_unzoomedPixmap;
 }
 
 void KPixmapRegionSelectorWidget::setPixmap(const QPixmap &pixmap)
 {
     Q_ASSERT(!pixmap.isNull()); // This class isn't designed to deal with null pixmaps.
+    d->m_previewWatcher.cancel();
+    d->m_sourceImage = pixmap.toImage();
+    d->m_rotation = 0;
+    d->m_zoomFactor = 1.0;
     d->m_originalPixmap = pixmap;
     d->m_unzoomedPixmap = pixmap;
-    d->m_label->setPixmap(pixmap);
+    d->m_linedPixmap = QPixmap();
     resetSelection();
 }
 
@@ -124,7 +289,8 @@ void KPixmapRegionSelectorWidgetPrivate::updatePixmap()
 {
     Q_ASSERT(!m_originalPixmap.isNull());
     if (m_originalPixmap.isNull()) {
-        m_label->setPixmap(m_originalPixmap);
+        m_linedPixmap = QPixmap();
+        m_canvas->update();
         return;
     }
     if (m_selectedRegion.width() > m_originalPixmap.width()) {
@@ -134,30 +300,30 @@ void KPixmapRegionSelectorWidgetPrivate::updatePixmap()
         m_selectedRegion.setHeight(m_originalPixmap.height());
     }
 
-    QPainter painter;
     if (m_linedPixmap.isNull()) {
         m_linedPixmap = m_originalPixmap;
         QPainter p(&m_linedPixmap);
         p.setCompositionMode(QPainter::CompositionMode_SourceAtop);
         p.fillRect(m_linedPixmap.rect(), QColor(0, 0, 0, 100));
+        p.end();
+
+        // The whole image changed: resize synchronously so that callers can rely
+        // on the canvas geometry, instead of flushing posted layout requests
+        m_canvas->setAttribute(Qt::WA_OpaquePaintEvent, !m_originalPixmap.hasAlphaChannel());
+        m_canvas->setFixedSize(m_originalPixmap.size());
+        m_canvas->update();
+    } else if (m_paintedRegion != m_selectedRegion) {
+        // Only the area between the old and the new selection changes its dimming
+        m_canvas->update(m_paintedRegion.united(m_selectedRegion));
     }
+    m_paintedRegion = m_selectedRegion;
 
-    QPixmap pixmap = m_linedPixmap;
-    painter.begin(&pixmap);
-    painter.drawPixmap(m_selectedRegion.topLeft(), m_originalPixmap, m_selectedRegion);
-
-    painter.end();
-
-    m_label->setPixmap(pixmap);
-
-    qApp->sendPostedEvents(nullptr, QEvent::LayoutRequest);
-
-    if (m_selectedRegion == m_originalPixmap.rect()) { // d->m_label->rect()) //### CHECK!
+    if (m_selectedRegion == m_originalPixmap.rect()) { // d->m_canvas->rect()) //### CHECK!
         m_rubberBand->hide();
     } else {
         m_rubberBand->setGeometry(QRect(m_selectedRegion.topLeft(), m_selectedRegion.size()));
 
-        /*        m_rubberBand->setGeometry(QRect(m_label -> mapToGlobal(m_selectedRegion.topLeft()),
+        /*        m_rubberBand->setGeometry(QRect(m_canvas -> mapToGlobal(m_selectedRegion.topLeft()),
                                                 m_selectedRegion.size()));
         */
         if (m_state != None) {
@@ -192,27 +358,20 @@ void KPixmapRegionSelectorWidget::rotate(RotateDirection direction)
 {
     int w = d->m_originalPixmap.width();
     int h = d->m_originalPixmap.height();
-    QImage img = d->m_unzoomedPixmap.toImage();
+    int quarterTurns;
     if (direction == Rotate90) {
-        img = img.transformed(QTransform().rotate(90.0));
+        quarterTurns = 1;
     } else if (direction == Rotate180) {
-        img = img.transformed(QTransform().rotate(180.0));
+        quarterTurns = 2;
     } else {
-        img = img.transformed(QTransform().rotate(270.0));
+        quarterTurns = 3;
     }
 
-    d->m_unzoomedPixmap = QPixmap::fromImage(img);
-
-    img = d->m_originalPixmap.toImage();
-    if (direction == Rotate90) {
-        img = img.transformed(QTransform().rotate(90.0));
-    } else if (direction == Rotate180) {
-        img = img.transformed(QTransform().rotate(180.0));
-    } else {
-        img = img.transformed(QTransform().rotate(270.0));
-    }
-
-    d->m_originalPixmap = QPixmap::fromImage(img);
+    // Only a new preview is built, the full resolution image just records the
+    // rotation, which gets applied to the selected region when it's extracted
+    d->m_rotation = (d->m_rotation + quarterTurns) % 4;
+    d->m_unzoomedPixmap = QPixmap();
+    d->buildPreview((quarterTurns % 2) ? d->m_originalPixmap.size().transposed() : d->m_originalPixmap.size());
 
     d->m_linedPixmap = QPixmap();
 
@@ -441,8 +600,7 @@ QRect KPixmapRegionSelectorWidget::unzoomedSelectedRegion() const
 
 QImage KPixmapRegionSelectorWidget::selectedImage() const
 {
-    QImage origImage = d->m_unzoomedPixmap.toImage();
-    return origImage.copy(unzoomedSelectedRegion());
+    return d->rotatedImage(d->m_sourceImage.copy(d->mapToSource(unzoomedSelectedRegion())));
 }
 
 void KPixmapRegionSelectorWidget::setSelectionAspectRatio(int width, int height)
@@ -463,19 +621,20 @@ void KPixmapRegionSelectorWidget::setMaximumWidgetSize(int width, int height)
     if (d->m_selectedRegion == d->m_originalPixmap.rect()) {
         d->m_selectedRegion = QRect();
     }
-    d->m_originalPixmap = d->m_unzoomedPixmap;
 
-    //   qCDebug(KWidgetsAddonsLog) << QString(" original Pixmap :") << d->m_originalPixmap.rect();
-    //   qCDebug(KWidgetsAddonsLog) << QString(" unzoomed Pixmap : %1 x %2 ").arg(d->m_unzoomedPixmap.width()).arg(d->m_unzoomedPixmap.height());
+    const QSize unzoomedSize = d->rotatedSourceSize();
+    if (!unzoomedSize.isEmpty()) {
+        QSize previewSize = unzoomedSize;
+        if (unzoomedSize.width() > d->m_maxWidth || unzoomedSize.height() > d->m_maxHeight) {
+            /* We have to resize the pixmap to get it complete on the screen */
+            previewSize = unzoomedSize.scaled(width, height, Qt::KeepAspectRatio);
+        }
+        d->buildPreview(previewSize);
 
-    if (!d->m_originalPixmap.isNull() && (d->m_originalPixmap.width() > d->m_maxWidth || d->m_originalPixmap.height() > d->m_maxHeight)) {
-        /* We have to resize the pixmap to get it complete on the screen */
-        QImage image = d->m_originalPixmap.toImage();
-        d->m_originalPixmap = QPixmap::fromImage(image.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation));
         double oldZoomFactor = d->m_zoomFactor;
-        d->m_zoomFactor = d->m_originalPixmap.width() / (double)d->m_unzoomedPixmap.width();
+        d->m_zoomFactor = d->m_originalPixmap.width() / (double)unzoomedSize.width();
 
-        if (d->m_selectedRegion.isValid()) {
+        if (d->m_selectedRegion.isValid() && d->m_zoomFactor != oldZoomFactor) {
             d->m_selectedRegion = QRect((int)(d->m_selectedRegion.x() * d->m_zoomFactor / oldZoomFactor),
                                         (int)(d->m_selectedRegion.y() * d->m_zoomFactor / oldZoomFactor),
                                         (int)(d->m_selectedRegion.width() * d->m_zoomFactor / oldZoomFactor),
@@ -489,5 +648,5 @@ void KPixmapRegionSelectorWidget::setMaximumWidgetSize(int width, int height)
 
     d->m_linedPixmap = QPixmap();
     d->updatePixmap();
-    resize(d->m_label->width(), d->m_label->height());
+    resize(d->m_canvas->width(), d->m_canvas->height());
 }
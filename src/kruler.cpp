@@ -6,6 +6,7 @@
 */
 
 #include "kruler.h"
+#include "ktracing_p.h"
 
 #include <QFont>
 #include <QPolygon>
@@ -53,12 +54,6 @@
 #define END_LABEL_X 4
 #define END_LABEL_Y (END_LABEL_X + LABEL_SIZE - 2)
 
-#undef PROFILING
-
-#ifdef PROFILING
-#include <qdatetime.h>
-#endif
-
 class KRulerPrivate
 {
 public:
@@ -533,11 +528,7 @@ void KRuler::paintEvent(QPaintEvent * /*e*/)
     //  debug ("KRuler::drawContents, %s",(horizontal==dir)?"horizontal":"vertical");
 
     QStylePainter p(this);
-#ifdef PROFILING
-    QTime time;
-    time.start();
-    for (int profile = 0; profile < 10; profile++) {
-#endif
+    KTRACE_SCOPE("KRuler::paintEvent");
 
         int value = this->value();
         int minval = minimum();
@@ -652,10 +643,4 @@ void KRuler::paintEvent(QPaintEvent * /*e*/)
             p.setBrush(p.background().color());
             p.drawPolygon(pa);
         }
-
-#ifdef PROFILING
-    }
-    int elapsed = time.elapsed();
-    debug("paint time %i", elapsed);
-#endif
 }
@@ -21,6 +21,7 @@
 #include "kselectaction.h"
 #include "kselectaction_p.h"
 
+#include "common_helpers_p.h"
 #include "loggingcategory.h"
 
 #include <QActionEvent>
@@ -34,19 +35,7 @@
 // display ampersands literally.
 static QString DropAmpersands(const QString &text)
 {
-    QString label = text;
-
-    int p = label.indexOf(QLatin1Char('&'));
-    while (p >= 0 && p < label.length() - 1) {
-        if (label[p + 1].isLetterOrNumber() // Valid accelerator.
-            || label[p + 1] == QLatin1Char('&')) { // Escaped accelerator marker.
-            label.remove(p, 1);
-        }
-
-        p = label.indexOf(QLatin1Char('&'), p + 1);
-    }
-
-    return label;
+    return stripAcceleratorMarkers(text, AcceleratorKind::LetterOrNumber);
 }
 
 KSelectAction::KSelectAction(QObject *parent)
@@ -8,9 +8,58 @@
 #include "kstandardguiitem.h"
 
 #include <QApplication>
+#include <QHash>
+#include <QPointer>
+#include <QThread>
 
 namespace KStandardGuiItem
 {
+/**
+ * @private Prevent kapidox's doxygen config to pick up this namespace class
+ * Created items, shared by all callers until the application language changes.
+ * Icons are resolved by KGuiItem through QIcon::fromTheme(), which follows icon theme changes itself.
+ */
+class GuiItemCache : public QObject
+{
+public:
+    explicit GuiItemCache(QCoreApplication *app)
+        : QObject(app)
+    {
+        app->installEventFilter(this);
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::LanguageChange && watched == parent()) {
+            items.clear();
+        }
+        return false;
+    }
+
+    QHash<int, KGuiItem> items; // keyed by StandardItem
+};
+
+/// @private Prevent kapidox's doxygen config to pick up this namespace variable
+static QPointer<GuiItemCache> s_guiItemCache;
+
+/// @private Prevent kapidox's doxygen config to pick up this namespace method
+static KGuiItem cachedItem(StandardItem id, KGuiItem (*createItem)())
+{
+    QCoreApplication *app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() != app->thread()) {
+        return createItem();
+    }
+
+    if (!s_guiItemCache) {
+        s_guiItemCache = new GuiItemCache(app);
+    }
+    auto it = s_guiItemCache->items.constFind(id);
+    if (it == s_guiItemCache->items.constEnd()) {
+        it = s_guiItemCache->items.insert(id, createItem());
+    }
+    return *it;
+}
+
 KGuiItem guiItem(StandardItem ui_enum)
 {
     switch (ui_enum) {
@@ -149,107 +198,135 @@ QString standardItem(StandardItem ui_enum)
 
 KGuiItem ok()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&OK"), QStringLiteral("dialog-ok"));
+    return cachedItem(Ok, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&OK"), QStringLiteral("dialog-ok"));
+    });
 }
 
 KGuiItem cancel()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Cancel"), QStringLiteral("dialog-cancel"));
+    return cachedItem(Cancel, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Cancel"), QStringLiteral("dialog-cancel"));
+    });
 }
 
 KGuiItem discard()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Discard"),
-                    QStringLiteral("edit-delete"),
-                    QApplication::translate("KStandardGuiItem", "Discard changes"),
-                    QApplication::translate("KStandardGuiItem",
-                                            "Pressing this button will discard all recent "
-                                            "changes made in this dialog."));
+    return cachedItem(Discard, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Discard"),
+                        QStringLiteral("edit-delete"),
+                        QApplication::translate("KStandardGuiItem", "Discard changes"),
+                        QApplication::translate("KStandardGuiItem",
+                                                "Pressing this button will discard all recent "
+                                                "changes made in this dialog."));
+    });
 }
 
 KGuiItem save()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Save"),
-                    QStringLiteral("document-save"),
-                    QApplication::translate("KStandardGuiItem", "Save data"));
+    return cachedItem(Save, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Save"),
+                        QStringLiteral("document-save"),
+                        QApplication::translate("KStandardGuiItem", "Save data"));
+    });
 }
 
 KGuiItem dontSave()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Do Not Save"), QString(), QApplication::translate("KStandardGuiItem", "Do not save data"));
+    return cachedItem(DontSave, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Do Not Save"), QString(), QApplication::translate("KStandardGuiItem", "Do not save data"));
+    });
 }
 
 KGuiItem saveAs()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "Save &As..."),
-                    QStringLiteral("document-save-as"),
-                    QApplication::translate("KStandardGuiItem", "Save file with another name"));
+    return cachedItem(SaveAs, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "Save &As..."),
+                        QStringLiteral("document-save-as"),
+                        QApplication::translate("KStandardGuiItem", "Save file with another name"));
+    });
 }
 
 KGuiItem apply()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Apply"),
-                    QStringLiteral("dialog-ok-apply"),
-                    QApplication::translate("KStandardGuiItem", "Apply changes"),
-                    QApplication::translate("KStandardGuiItem",
-                                            "When you click <b>Apply</b>, the settings will be "
-                                            "handed over to the program, but the dialog "
-                                            "will not be closed.\n"
-                                            "Use this to try different settings."));
+    return cachedItem(Apply, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Apply"),
+                        QStringLiteral("dialog-ok-apply"),
+                        QApplication::translate("KStandardGuiItem", "Apply changes"),
+                        QApplication::translate("KStandardGuiItem",
+                                                "When you click <b>Apply</b>, the settings will be "
+                                                "handed over to the program, but the dialog "
+                                                "will not be closed.\n"
+                                                "Use this to try different settings."));
+    });
 }
 
 KGuiItem adminMode()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "Administrator &Mode..."),
-                    QString(),
-                    QApplication::translate("KStandardGuiItem", "Enter Administrator Mode"),
-                    QApplication::translate("KStandardGuiItem",
-                                            "When you click <b>Administrator Mode</b> you will be prompted "
-                                            "for the administrator (root) password in order to make changes "
-                                            "which require root privileges."));
+    return cachedItem(AdminMode, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "Administrator &Mode..."),
+                        QString(),
+                        QApplication::translate("KStandardGuiItem", "Enter Administrator Mode"),
+                        QApplication::translate("KStandardGuiItem",
+                                                "When you click <b>Administrator Mode</b> you will be prompted "
+                                                "for the administrator (root) password in order to make changes "
+                                                "which require root privileges."));
+    });
 }
 
 KGuiItem clear()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "C&lear"),
-                    QStringLiteral("edit-clear"),
-                    QApplication::translate("KStandardGuiItem", "Clear input"),
-                    QApplication::translate("KStandardGuiItem", "Clear the input in the edit field"));
+    return cachedItem(Clear, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "C&lear"),
+                        QStringLiteral("edit-clear"),
+                        QApplication::translate("KStandardGuiItem", "Clear input"),
+                        QApplication::translate("KStandardGuiItem", "Clear the input in the edit field"));
+    });
 }
 
 KGuiItem help()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Help", "show help"),
-                    QStringLiteral("help-contents"),
-                    QApplication::translate("KStandardGuiItem", "Show help"));
+    return cachedItem(Help, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Help", "show help"),
+                        QStringLiteral("help-contents"),
+                        QApplication::translate("KStandardGuiItem", "Show help"));
+    });
 }
 
 KGuiItem close()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Close"),
-                    QStringLiteral("window-close"),
-                    QApplication::translate("KStandardGuiItem", "Close the current window or document"));
+    return cachedItem(Close, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Close"),
+                        QStringLiteral("window-close"),
+                        QApplication::translate("KStandardGuiItem", "Close the current window or document"));
+    });
 }
 
 KGuiItem closeWindow()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Close Window"),
-                    QStringLiteral("window-close"),
-                    QApplication::translate("KStandardGuiItem", "Close the current window."));
+    return cachedItem(CloseWindow, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Close Window"),
+                        QStringLiteral("window-close"),
+                        QApplication::translate("KStandardGuiItem", "Close the current window."));
+    });
 }
 
 KGuiItem closeDocument()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Close Document"),
-                    QStringLiteral("document-close"),
-                    QApplication::translate("KStandardGuiItem", "Close the current document."));
+    return cachedItem(CloseDocument, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Close Document"),
+                        QStringLiteral("document-close"),
+                        QApplication::translate("KStandardGuiItem", "Close the current document."));
+    });
 }
 
 KGuiItem defaults()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Defaults"),
-                    QStringLiteral("document-revert"),
-                    QApplication::translate("KStandardGuiItem", "Reset all items to their default values"));
+    return cachedItem(Defaults, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Defaults"),
+                        QStringLiteral("document-revert"),
+                        QApplication::translate("KStandardGuiItem", "Reset all items to their default values"));
+    });
 }
 
 KGuiItem back(BidiMode useBidi)
@@ -273,91 +350,121 @@ QPair<KGuiItem, KGuiItem> backAndForward()
 
 KGuiItem print()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Print..."),
-                    QStringLiteral("document-print"),
-                    QApplication::translate("KStandardGuiItem",
-                                            "Opens the print dialog to print "
-                                            "the current document"));
+    return cachedItem(Print, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Print..."),
+                        QStringLiteral("document-print"),
+                        QApplication::translate("KStandardGuiItem",
+                                                "Opens the print dialog to print "
+                                                "the current document"));
+    });
 }
 
 KGuiItem cont()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "C&ontinue"),
-                    QStringLiteral("arrow-right"),
-                    QApplication::translate("KStandardGuiItem", "Continue operation"));
+    return cachedItem(Continue, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "C&ontinue"),
+                        QStringLiteral("arrow-right"),
+                        QApplication::translate("KStandardGuiItem", "Continue operation"));
+    });
 }
 
 KGuiItem del()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Delete"),
-                    QStringLiteral("edit-delete"),
-                    QApplication::translate("KStandardGuiItem", "Delete item(s)"));
+    return cachedItem(Delete, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Delete"),
+                        QStringLiteral("edit-delete"),
+                        QApplication::translate("KStandardGuiItem", "Delete item(s)"));
+    });
 }
 
 KGuiItem open()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Open..."),
-                    QStringLiteral("document-open"),
-                    QApplication::translate("KStandardGuiItem", "Open file"));
+    return cachedItem(Open, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Open..."),
+                        QStringLiteral("document-open"),
+                        QApplication::translate("KStandardGuiItem", "Open file"));
+    });
 }
 
 KGuiItem quit()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Quit"),
-                    QStringLiteral("application-exit"),
-                    QApplication::translate("KStandardGuiItem", "Quit application"));
+    return cachedItem(Quit, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Quit"),
+                        QStringLiteral("application-exit"),
+                        QApplication::translate("KStandardGuiItem", "Quit application"));
+    });
 }
 
 KGuiItem reset()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Reset"),
-                    QStringLiteral("edit-undo"),
-                    QApplication::translate("KStandardGuiItem", "Reset configuration"));
+    return cachedItem(Reset, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Reset"),
+                        QStringLiteral("edit-undo"),
+                        QApplication::translate("KStandardGuiItem", "Reset configuration"));
+    });
 }
 
 KGuiItem insert()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Insert", "Verb"));
+    return cachedItem(Insert, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Insert", "Verb"));
+    });
 }
 
 KGuiItem configure()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "Confi&gure..."), QStringLiteral("configure"));
+    return cachedItem(Configure, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "Confi&gure..."), QStringLiteral("configure"));
+    });
 }
 
 KGuiItem find()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Find"), QStringLiteral("edit-find"));
+    return cachedItem(Find, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Find"), QStringLiteral("edit-find"));
+    });
 }
 
 KGuiItem stop()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "Stop"), QStringLiteral("process-stop"));
+    return cachedItem(Stop, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "Stop"), QStringLiteral("process-stop"));
+    });
 }
 
 KGuiItem add()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "Add"), QStringLiteral("list-add"));
+    return cachedItem(Add, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "Add"), QStringLiteral("list-add"));
+    });
 }
 
 KGuiItem remove()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "Remove"), QStringLiteral("list-remove"));
+    return cachedItem(Remove, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "Remove"), QStringLiteral("list-remove"));
+    });
 }
 
 KGuiItem test()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "Test"));
+    return cachedItem(Test, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "Test"));
+    });
 }
 
 KGuiItem properties()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "Properties"), QStringLiteral("document-properties"));
+    return cachedItem(Properties, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "Properties"), QStringLiteral("document-properties"));
+    });
 }
 
 KGuiItem overwrite()
 {
-    return KGuiItem(QApplication::translate("KStandardGuiItem", "&Overwrite"), QStringLiteral("document-replace"));
+    return cachedItem(Overwrite, []() {
+        return KGuiItem(QApplication::translate("KStandardGuiItem", "&Overwrite"), QStringLiteral("document-replace"));
+    });
 }
 
 void assign(QPushButton *button, StandardItem item)
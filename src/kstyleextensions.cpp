@@ -7,6 +7,8 @@
 
 #include "kstyleextensions.h"
 
+#include <QHash>
+#include <QMetaObject>
 #include <QWidget>
 
 namespace KStyleExtensions
@@ -53,22 +55,63 @@ static const QStyle::StyleHint SH_KCustomStyleElement = (QStyle::StyleHint)0xff0
 /// @private Prevent kapidox's doxygen config to pick up this namespace variable
 static const int X_KdeBase = 0xff000000;
 
+/// @private Prevent kapidox's doxygen config to pick up this namespace class
+struct StyleElements {
+    bool supportsCustomElements = false;
+    // keyed by the class of the querying widget and the element name
+    QHash<std::pair<const QMetaObject *, QString>, int> ids;
+};
+
+/// @private Prevent kapidox's doxygen config to pick up this namespace variable
+using StyleElementsCache = QHash<const QStyle *, StyleElements>;
+Q_GLOBAL_STATIC(StyleElementsCache, s_styleElementsCache)
+
 /*
     The functions called by widgets that request custom element support, passed to the effective style.
     Collected in a static inline function due to similarity.
+
+    The ids a style supports don't change during its lifetime, so they are cached per style, which
+    spares renaming the widget on repeated queries. A style may answer differently depending on the
+    widget class, so the class is part of the key. Entries are dropped when the style is deleted,
+    a widget changing its style queries the cache of the new one.
 */
 
 /// @private Prevent kapidox's doxygen config to pick up this namespace method
 static inline int customStyleElement(QStyle::StyleHint type, const QString &element, QWidget *widget)
 {
-    if (!widget || widget->style()->metaObject()->indexOfClassInfo("X-KDE-CustomElements") < 0) {
+    if (!widget) {
         return 0;
     }
 
+    QStyle *style = widget->style();
+    auto it = s_styleElementsCache->find(style);
+    if (it == s_styleElementsCache->end()) {
+        StyleElements elements;
+        elements.supportsCustomElements = style->metaObject()->indexOfClassInfo("X-KDE-CustomElements") >= 0;
+        it = s_styleElementsCache->insert(style, elements);
+        QObject::connect(style, &QObject::destroyed, [style]() {
+            if (!s_styleElementsCache.isDestroyed()) {
+                s_styleElementsCache->remove(style);
+            }
+        });
+    }
+
+    if (!it->supportsCustomElements) {
+        return 0;
+    }
+
+    const auto key = std::make_pair(widget->metaObject(), element);
+    const auto idIt = it->ids.constFind(key);
+    if (idIt != it->ids.constEnd()) {
+        return *idIt;
+    }
+
     const QString originalName = widget->objectName();
     widget->setObjectName(element);
-    const int id = widget->style()->styleHint(type, nullptr, widget);
+    const int id = style->styleHint(type, nullptr, widget);
     widget->setObjectName(originalName);
+    // don't reuse it, the style might have queried other elements meanwhile
+    (*s_styleElementsCache)[style].ids.insert(key, id);
     return id;
 }
 
@@ -0,0 +1,159 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "ktracing_p.h"
+
+#ifdef KWIDGETSADDONS_TRACING
+
+#include "loggingcategory.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+
+#include <vector>
+
+namespace
+{
+// keeps a forgotten trace file from eating all the memory
+constexpr std::size_t MaxEvents = 1000000;
+
+struct TraceEvent {
+    const char *name;
+    char phase; // 'X' for spans, 'B' and 'E' for their begin and end, 'C' for counters
+    qint64 timestamp;
+    qint64 value; // the duration for spans
+    quintptr thread;
+};
+
+class Tracer
+{
+public:
+    Tracer()
+        : fileName(qEnvironmentVariable("KWIDGETSADDONS_TRACE_FILE"))
+    {
+        timer.start();
+    }
+
+    ~Tracer()
+    {
+        write();
+    }
+
+    void add(const char *name, char phase, qint64 timestamp, qint64 value)
+    {
+        const QMutexLocker locker(&mutex);
+        if (events.size() >= MaxEvents) {
+            return;
+        }
+        events.push_back({name, phase, timestamp, value, reinterpret_cast<quintptr>(QThread::currentThreadId())});
+    }
+
+    void write();
+
+    const QString fileName;
+    QElapsedTimer timer;
+    QMutex mutex;
+    std::vector<TraceEvent> events;
+    QHash<const char *, qint64> counts;
+};
+
+Q_GLOBAL_STATIC(Tracer, s_tracer)
+
+void Tracer::write()
+{
+    const QMutexLocker locker(&mutex);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    for (const TraceEvent &event : events) {
+        QJsonObject object{
+            {QStringLiteral("name"), QString::fromLatin1(event.name)},
+            {QStringLiteral("cat"), QStringLiteral("kwidgetsaddons")},
+            {QStringLiteral("ph"), QString(QLatin1Char(event.phase))},
+            {QStringLiteral("ts"), event.timestamp},
+            {QStringLiteral("pid"), pid},
+            {QStringLiteral("tid"), qint64(event.thread)},
+        };
+        if (event.phase == 'X') {
+            object.insert(QStringLiteral("dur"), event.value);
+        } else if (event.phase == 'C') {
+            object.insert(QStringLiteral("args"), QJsonObject{{QStringLiteral("value"), event.value}});
+        }
+        traceEvents.append(object);
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(KWidgetsAddonsLog) << "Could not write the trace to" << fileName << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(QJsonObject{{QStringLiteral("traceEvents"), traceEvents}}).toJson(QJsonDocument::Compact));
+}
+}
+
+bool KTracing::isEnabled()
+{
+    static const bool enabled = !qEnvironmentVariableIsEmpty("KWIDGETSADDONS_TRACE_FILE");
+    // nothing can be recorded anymore once the trace has been written on exit
+    return enabled && !s_tracer.isDestroyed();
+}
+
+qint64 KTracing::timestamp()
+{
+    return !s_tracer.isDestroyed() ? s_tracer->timer.nsecsElapsed() / 1000 : 0;
+}
+
+void KTracing::addSpan(const char *name, qint64 start, qint64 duration)
+{
+    if (isEnabled()) {
+        s_tracer->add(name, 'X', start, duration);
+    }
+}
+
+void KTracing::beginSpan(const char *name)
+{
+    if (isEnabled()) {
+        s_tracer->add(name, 'B', timestamp(), 0);
+    }
+}
+
+void KTracing::endSpan(const char *name)
+{
+    if (isEnabled()) {
+        s_tracer->add(name, 'E', timestamp(), 0);
+    }
+}
+
+void KTracing::setCounter(const char *name, qint64 value)
+{
+    if (isEnabled()) {
+        s_tracer->add(name, 'C', timestamp(), value);
+    }
+}
+
+void KTracing::incrementCounter(const char *name)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    qint64 value;
+    {
+        const QMutexLocker locker(&s_tracer->mutex);
+        value = ++s_tracer->counts[name];
+    }
+    s_tracer->add(name, 'C', timestamp(), value);
+}
+
+#endif
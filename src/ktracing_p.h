@@ -0,0 +1,85 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KTRACING_P_H
+#define KTRACING_P_H
+
+#include <QtGlobal>
+
+/*
+ * Optional tracing of where time is spent in the widgets, enabled with the
+ * KWIDGETSADDONS_TRACING CMake option. Without it the macros expand to nothing.
+ *
+ * With it, nothing is recorded either unless the KWIDGETSADDONS_TRACE_FILE
+ * environment variable names a file. On exit, the recorded spans and counters
+ * are written to that file in the Chrome trace event format, which can be
+ * opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ * Names must be string literals, they are stored as pointers.
+ *
+ * KTRACE_SCOPE(name)            records the time until the end of the scope
+ * KTRACE_BEGIN(name), KTRACE_END(name)
+ *                               record the time between two points in the same function
+ * KTRACE_COUNTER(name, value)   records the current value of a counter
+ * KTRACE_COUNT(name)            increments a counter by one
+ */
+
+#ifdef KWIDGETSADDONS_TRACING
+
+namespace KTracing
+{
+bool isEnabled();
+qint64 timestamp();
+void addSpan(const char *name, qint64 start, qint64 duration);
+void beginSpan(const char *name);
+void endSpan(const char *name);
+void setCounter(const char *name, qint64 value);
+void incrementCounter(const char *name);
+
+class Span
+{
+public:
+    explicit Span(const char *name)
+        : m_name(name)
+        , m_start(isEnabled() ? timestamp() : -1)
+    {
+    }
+
+    ~Span()
+    {
+        if (m_start >= 0) {
+            addSpan(m_name, m_start, timestamp() - m_start);
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(Span)
+
+    const char *const m_name;
+    const qint64 m_start;
+};
+}
+
+#define KTRACE_CONCAT_IMPL(a, b) a##b
+#define KTRACE_CONCAT(a, b) KTRACE_CONCAT_IMPL(a, b)
+#define KTRACE_SCOPE(name) const KTracing::Span KTRACE_CONCAT(ktraceSpan, __LINE__)(name)
+#define KTRACE_BEGIN(name) KTracing::beginSpan(name)
+#define KTRACE_END(name) KTracing::endSpan(name)
+#define KTRACE_COUNTER(name, value) KTracing::setCounter(name, value)
+#define KTRACE_COUNT(name) KTracing::incrementCounter(name)
+
+#else
+
+#define KTRACE_SCOPE(name) static_cast<void>(0)
+#define KTRACE_BEGIN(name) static_cast<void>(0)
+#define KTRACE_END(name) static_cast<void>(0)
+#define KTRACE_COUNTER(name, value) static_cast<void>(0)
+#define KTRACE_COUNT(name) static_cast<void>(0)
+
+#endif
+
+#endif // KTRACING_P_H
@@ -29,6 +29,8 @@ public:
         , floatEnabled(false)
         , timer(new QTimer(parent))
     {
+        // Only used to briefly show the selected color after a click
+        timer->setSingleShot(true);
         QObject::connect(timer, &QTimer::timeout, parent, [this]() {
             updateColor();
         });
@@ -38,7 +40,9 @@ public:
     {
         timer->stop();
 
-        if (!(glowEnabled || floatEnabled) || !parent->rect().contains(parent->mapFromGlobal(QCursor::pos()))) {
+        // The hover state is maintained by Qt from the enter and leave events,
+        // which spares asking the windowing system for the cursor position
+        if (!(glowEnabled || floatEnabled) || !parent->underMouse()) {
             setLinkColor(linkColor);
         }
     }